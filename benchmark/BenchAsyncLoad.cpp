@@ -0,0 +1,189 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Time a UI thread is blocked per track change: loading the lyric with
+// LyricSnapshot::reload_file() on that thread against LyricAsyncLoader, where
+// the UI thread only queues the load and later runs the completion callback
+// that publishes the document. A burst of skips shows the stale loads that
+// the cancel tokens drop.
+#include "benchutils.h"
+#include <lyricasync.h>
+#include <lyricscheduler.h>
+#include <lyricsnapshot.h>
+#include <textfilehelper.h>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+// the UI event loop, callbacks posted from the workers wait here
+class UiLoop
+{
+public:
+    AudioToolKits::LyricAsyncLoader::Executor executor()
+    {
+        return [this](AudioToolKits::LyricAsyncLoader::Task task)
+        {
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_posted.notify_one();
+        };
+    }
+
+    // blocks for the next task, returns the time spent running it
+    double run_one()
+    {
+        AudioToolKits::LyricAsyncLoader::Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_posted.wait(lock, [this]()
+            {
+                return !m_tasks.empty();
+            });
+            task = std::move(m_tasks.front());
+            m_tasks.erase(m_tasks.begin());
+        }
+        const auto begin = LPBench::Clock::now();
+        task();
+        return LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3;
+    }
+
+private:
+    std::mutex m_mutex;
+
+    std::condition_variable m_posted;
+
+    std::vector<AudioToolKits::LyricAsyncLoader::Task> m_tasks;
+};
+
+void report(const char* name, const std::vector<double>& us)
+{
+    std::printf("    %-26s p50 %9.1f us  p99 %9.1f us\n"
+                , name
+                , LPBench::percentile(us, 0.5)
+                , LPBench::percentile(us, 0.99));
+}
+}
+
+int main()
+{
+    constexpr size_t track_count{40};
+
+    // 1. Tracks, a song and a long transcript alternating, every other one GBK
+    const auto directory = std::filesystem::temp_directory_path() / "lp_bench_async";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < track_count; ++i)
+    {
+        std::string bytes;
+        auto lines = LPBench::make_lrc(i % 2 == 0 ? 80 : 4000, 1500, i % 4 == 0 ? 6 : 0);
+        for (size_t line = 2; line < lines.size(); ++line)
+        {
+            lines[line] += " 窗透初晓 日照西桥 云自摇";
+        }
+        for (const auto& line : lines)
+        {
+            bytes += line + "\n";
+        }
+        if (i % 3 == 1)
+        {
+            bytes = AudioToolKits::TextFileHelper::convert_encoding(bytes
+                                                                    , AudioToolKits::Encoding::UTF8
+                                                                    , AudioToolKits::Encoding::GBK);
+        }
+        paths.push_back((directory / ("track" + std::to_string(i) + ".lrc")).string());
+        std::ofstream{paths.back(), std::ios::binary} << bytes;
+    }
+    // 1.
+
+    // 2. Before: the UI thread loads the lyric itself
+    AudioToolKits::LyricSnapshot sync_snapshot;
+    std::vector<double> sync_us;
+    for (const auto& path : paths)
+    {
+        const auto begin = LPBench::Clock::now();
+        sync_snapshot.reload_file(path);
+        sync_us.push_back(LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3);
+    }
+    // 2.
+
+    // 3. After: queue the load, publish from the completion callback
+    AudioToolKits::LyricWorkStealingPool pool{1};
+    AudioToolKits::LyricAsyncLoader loader{pool};
+    UiLoop ui;
+    AudioToolKits::LyricSnapshot async_snapshot;
+    std::vector<double> submit_us;
+    std::vector<double> callback_us;
+    std::vector<double> latency_us;
+    for (const auto& path : paths)
+    {
+        const auto begin = LPBench::Clock::now();
+        loader.load_file(path
+                         , {}
+                         , ui.executor()
+                         , [&async_snapshot](AudioToolKits::LyricLoadResult&& result)
+                         {
+                             if (result.loaded())
+                             {
+                                 async_snapshot.publish(std::move(result.m_document));
+                             }
+                         });
+        submit_us.push_back(LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3);
+        callback_us.push_back(ui.run_one());
+        latency_us.push_back(LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3);
+    }
+    // 3.
+
+    // 4. Skip burst: every track is skipped before its lyric arrives but the last
+    std::vector<double> skip_us;
+    size_t delivered{0};
+    size_t dropped{0};
+    AudioToolKits::LyricCancelToken token;
+    for (const auto& path : paths)
+    {
+        const auto begin = LPBench::Clock::now();
+        token.cancel();
+        token = {};
+        loader.load_file(path
+                         , token
+                         , ui.executor()
+                         , [&async_snapshot, &delivered, &dropped](AudioToolKits::LyricLoadResult&& result)
+                         {
+                             if (result.loaded())
+                             {
+                                 ++delivered;
+                                 async_snapshot.publish(std::move(result.m_document));
+                             }
+                             else
+                             {
+                                 ++dropped;
+                             }
+                         });
+        skip_us.push_back(LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3);
+    }
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        ui.run_one();
+    }
+    // 4.
+
+    std::cout << track_count << " track changes, 80 and 4000 line lyrics alternating\n"
+              << "  UI thread blocked per change\n";
+    report("reload_file (before)", sync_us);
+    report("load_file submit", submit_us);
+    report("completion callback", callback_us);
+    std::cout << "  lyric ready after\n";
+    report("async load", latency_us);
+    std::cout << "  skip burst of " << track_count << " tracks\n";
+    report("skip + load_file submit", skip_us);
+    std::cout << "    delivered " << delivered << ", dropped " << dropped
+              << ", published " << async_snapshot.load()->get_text().size() << " lines\n"
+              << std::flush;
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,105 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Bulk load of many small lyric files: TextFileHelper's ifstream path, the
+// thread-pool loader and the io_uring loader, then io_uring feeding parser
+// workers. The corpus is freshly written, so reads hit the page cache.
+#include "benchutils.h"
+#include <boundedqueue.h>
+#include <lyricloader.h>
+#include <lyricparser.h>
+#include <textfilehelper.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    constexpr size_t file_count{5000};
+
+    // 1. Corpus
+    const auto directory = std::filesystem::temp_directory_path() / "lp_bench_loader";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        paths.push_back((directory / ("song" + std::to_string(i) + ".lrc")).string());
+        std::ofstream out{paths.back(), std::ios::binary};
+        for (const auto& line : LPBench::make_lrc(30, 4000, 0))
+        {
+            out << line << '\n';
+        }
+    }
+    // 1.
+
+    // 2. ifstream, one file after another
+    size_t lines{0};
+    auto begin = LPBench::Clock::now();
+    for (const auto& path : paths)
+    {
+        const AudioToolKits::TextFileHelper file{path};
+        lines += file.content().size();
+    }
+    const double ifstream_s = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e9;
+    std::cout << "ifstream:     " << file_count / ifstream_s << " files/s, "
+              << "system calls not counted (open, fstat, read until EOF, close)\n";
+    // 2.
+
+    // 3. Loader backends
+    const auto report = [](const char* name, const AudioToolKits::LyricLoaderStats& stats)
+    {
+        std::cout << name << stats.files_per_second() << " files/s, "
+                  << stats.syscalls_per_file() << " system calls per file\n";
+    };
+    const auto discard = [](AudioToolKits::LyricLoadedFile&&)
+    {
+    };
+    const AudioToolKits::LyricBatchLoader pool{AudioToolKits::LyricBatchLoader::Backend::ThreadPool};
+    report("thread pool:  ", pool.load(paths, discard));
+    const AudioToolKits::LyricBatchLoader uring{AudioToolKits::LyricBatchLoader::Backend::IoUring};
+    if (uring.backend() == AudioToolKits::LyricBatchLoader::Backend::IoUring)
+    {
+        report("io_uring:     ", uring.load(paths, discard));
+    }
+    else
+    {
+        std::cout << "io_uring:     unavailable\n";
+    }
+    // 3.
+
+    // 4. Loader feeding parser workers through a bounded queue
+    AudioToolKits::BoundedQueue<AudioToolKits::LyricLoadedFile> queue{256};
+    std::atomic<size_t> parsed_lines{0};
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < std::max(std::thread::hardware_concurrency(), 2u) - 1; ++i)
+    {
+        workers.emplace_back([&queue, &parsed_lines]()
+        {
+            while (auto file = queue.pop())
+            {
+                AudioToolKits::LyricParser parser;
+                parser.parse_lrc(AudioToolKits::TextFileHelper::split_lines(file->m_bytes));
+                parsed_lines += parser.get_lrc().size();
+            }
+        });
+    }
+    begin = LPBench::Clock::now();
+    uring.load(paths
+               , [&queue](AudioToolKits::LyricLoadedFile&& file)
+               {
+                   queue.push(std::move(file));
+               });
+    queue.close();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    const double parse_s = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e9;
+    std::cout << "load + parse: " << file_count / parse_s << " files/s, "
+              << parsed_lines.load() << " lines (" << lines << " read)" << std::endl;
+    // 4.
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,78 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Millions of (song, timestamp) lookups: LyricBatchResolver against one
+// LyricTimeline::find_line() per query.
+#include "benchutils.h"
+#include <lyricbatch.h>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+
+int main()
+{
+    constexpr size_t document_count{2000};
+    constexpr size_t query_count{4000000};
+
+    std::mt19937_64 random{7};
+    std::uniform_int_distribution<size_t> line_dist{20, 120};
+
+    std::vector<std::unique_ptr<AudioToolKits::LyricTimeline>> timelines;
+    std::vector<const AudioToolKits::LyricTimeline*> documents;
+    std::vector<int64_t> durations;
+    for (size_t d = 0; d < document_count; ++d)
+    {
+        const size_t line_count = line_dist(random);
+        AudioToolKits::LyricParser parser;
+        parser.parse_lrc(LPBench::make_lrc(line_count, 3500, 0));
+        timelines.emplace_back(std::make_unique<AudioToolKits::LyricTimeline>(parser));
+        documents.push_back(timelines.back().get());
+        durations.push_back(static_cast<int64_t>(line_count) * 3500);
+    }
+
+    std::uniform_int_distribution<uint32_t> document_dist{0, document_count - 1};
+    std::vector<AudioToolKits::LyricTimeQuery> queries(query_count);
+    for (auto& query : queries)
+    {
+        query.m_document = document_dist(random);
+        query.m_time_ms = static_cast<int64_t>(random() % static_cast<uint64_t>(
+                                                   durations[query.m_document]));
+    }
+
+    AudioToolKits::LyricBatchResolver resolver{documents};
+    std::vector<uint32_t> batched;
+    auto begin = LPBench::Clock::now();
+    resolver.resolve(queries, batched);
+    const double batched_ns = LPBench::elapsed_ns(begin, LPBench::Clock::now());
+
+    std::vector<uint32_t> single(query_count);
+    begin = LPBench::Clock::now();
+    for (size_t i = 0; i < query_count; ++i)
+    {
+        single[i] = static_cast<uint32_t>(
+            documents[queries[i].m_document]->find_line(queries[i].m_time_ms));
+    }
+    const double single_ns = LPBench::elapsed_ns(begin, LPBench::Clock::now());
+
+    // event logs are often already in time order per song
+    auto sorted_queries = queries;
+    std::sort(sorted_queries.begin()
+              , sorted_queries.end()
+              , [](const AudioToolKits::LyricTimeQuery& a
+                   , const AudioToolKits::LyricTimeQuery& b)
+              {
+                  return a.m_time_ms < b.m_time_ms;
+              });
+    std::vector<uint32_t> merged;
+    begin = LPBench::Clock::now();
+    resolver.resolve(sorted_queries, merged);
+    const double merged_ns = LPBench::elapsed_ns(begin, LPBench::Clock::now());
+
+    std::cout << "documents:             " << document_count << "\n"
+              << "queries:               " << query_count << "\n"
+              << "batched queries/s:     " << query_count / (batched_ns / 1e9) << "\n"
+              << "time-ordered batch/s: " << query_count / (merged_ns / 1e9) << "\n"
+              << "per-query queries/s:   " << query_count / (single_ns / 1e9) << "\n"
+              << "results identical:     " << (batched == single ? "yes" : "no") << std::endl;
+}
@@ -0,0 +1,55 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Resident memory of a corpus held as LyricLine vectors against one
+// LyricCompactStore, extrapolated to two million songs.
+#include "benchutils.h"
+#include <lyriccompact.h>
+#include <iostream>
+
+int main()
+{
+    constexpr size_t song_count{2000};
+    constexpr size_t line_count{60};
+    constexpr double corpus_songs{2'000'000.0};
+
+    // short CJK lines just past SSO, as most real lyric lines are
+    const std::vector<std::string> phrases{
+        "窗外的麻雀在电线杆上多嘴"
+        , "你说这一句很有夏天的感觉"
+        , "手中的铅笔在纸上来来回回"
+        , "I've been waiting for a long time"
+    };
+
+    size_t line_bytes{0};
+    AudioToolKits::LyricCompactStore store;
+    for (size_t song = 0; song < song_count; ++song)
+    {
+        auto lrc = LPBench::make_lrc(line_count, 3500, 0);
+        for (size_t line = 2; line < lrc.size(); ++line)
+        {
+            lrc[line] = lrc[line].substr(0, 11) + phrases[(song + line) % phrases.size()];
+        }
+        AudioToolKits::LyricParser parser;
+        parser.parse_lrc(lrc);
+        const auto lines = parser.get_lrc();
+        line_bytes += AudioToolKits::LyricCompactStore::memory_usage(lines);
+        if (store.add(lines) == AudioToolKits::LyricCompactStore::npos)
+        {
+            return 1;
+        }
+    }
+    store.shrink_to_fit();
+
+    const size_t compact_bytes = store.memory_usage();
+    const double scale = corpus_songs / song_count / (1024.0 * 1024.0 * 1024.0);
+    std::cout << "sizeof(LyricLine):        " << sizeof(AudioToolKits::LyricLine) << " bytes\n"
+              << "sizeof(LyricCompactLine): " << sizeof(AudioToolKits::LyricCompactLine) << " bytes\n"
+              << "LyricLine vectors:        " << line_bytes / song_count << " bytes per song, "
+              << line_bytes * scale << " GiB per 2M songs\n"
+              << "LyricCompactStore:        " << compact_bytes / song_count << " bytes per song, "
+              << compact_bytes * scale << " GiB per 2M songs\n"
+              << "ratio:                    "
+              << static_cast<double>(line_bytes) / static_cast<double>(compact_bytes) << "x"
+              << std::endl;
+}
@@ -0,0 +1,128 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Consumers that only need the head of a long transcript (a preview of the
+// first lines, the first line matching a search) through a full
+// LyricParser::parse_buffer() against LyricLineGenerator, which stops parsing
+// when the loop breaks. A full generator pass shows the coroutine overhead.
+#include "benchutils.h"
+#include <lyricgenerator.h>
+#include <iostream>
+
+namespace
+{
+constexpr int s_rounds{15};
+
+template <typename Run>
+double best_us(Run&& run)
+{
+    double best = 0;
+    for (int round = 0; round < s_rounds; ++round)
+    {
+        const auto begin = LPBench::Clock::now();
+        run();
+        const double us = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3;
+        best = round == 0 ? us : std::min(best, us);
+    }
+    return best;
+}
+}
+
+int main()
+{
+    constexpr size_t line_count{20000};
+    constexpr size_t preview_lines{10};
+    const std::string needle{"line number 500 "};
+
+    std::string buffer;
+    for (const auto& line : LPBench::make_lrc(line_count, 1500, 0))
+    {
+        buffer += line + "\r\n";
+    }
+
+    size_t parser_found{0};
+    const double parser_preview_us = best_us([&buffer]
+    {
+        AudioToolKits::LyricParser parser;
+        parser.parse_buffer(buffer);
+        const auto text = parser.get_text();
+        volatile size_t bytes{0};
+        for (size_t i = 0; i < preview_lines && i < text.size(); ++i)
+        {
+            bytes = bytes + text[i].m_text.size();
+        }
+    });
+    const double parser_search_us = best_us([&buffer, &needle, &parser_found]
+    {
+        AudioToolKits::LyricParser parser;
+        parser.parse_buffer(buffer);
+        for (const auto& line : parser.get_text())
+        {
+            if (std::string_view{line.m_text}.find(needle) != std::string_view::npos)
+            {
+                parser_found = static_cast<size_t>(line.start_ms());
+                break;
+            }
+        }
+    });
+
+    size_t generator_found{0};
+    size_t generator_lines{0};
+    const double generator_preview_us = best_us([&buffer]
+    {
+        size_t count{0};
+        volatile size_t bytes{0};
+        for (const auto& line : AudioToolKits::LyricLineGenerator::from_buffer(buffer))
+        {
+            if (line.isText())
+            {
+                bytes = bytes + line.m_text.size();
+                if (++count == preview_lines)
+                {
+                    break;
+                }
+            }
+        }
+    });
+    const double generator_search_us = best_us([&buffer, &needle, &generator_found]
+    {
+        for (const auto& line : AudioToolKits::LyricLineGenerator::from_buffer(buffer))
+        {
+            if (line.isText() && line.m_text.find(needle) != std::string_view::npos)
+            {
+                generator_found = static_cast<size_t>(line.start_ms());
+                break;
+            }
+        }
+    });
+    const double generator_full_us = best_us([&buffer, &generator_lines]
+    {
+        generator_lines = 0;
+        for (const auto& line : AudioToolKits::LyricLineGenerator::from_buffer(buffer))
+        {
+            generator_lines += line.isText();
+        }
+    });
+
+    const double parser_full_us = best_us([&buffer]
+    {
+        AudioToolKits::LyricParser parser;
+        parser.parse_buffer(buffer);
+    });
+
+    std::cout << "transcript of " << line_count << " lines, " << buffer.size() / 1024 << " KiB\n"
+              << "  first " << preview_lines << " lines\n"
+              << "    parse_buffer:       " << parser_preview_us << " us\n"
+              << "    generator:          " << generator_preview_us << " us, "
+              << parser_preview_us / generator_preview_us << "x\n"
+              << "  first line matching \"" << needle << "\"\n"
+              << "    parse_buffer:       " << parser_search_us << " us\n"
+              << "    generator:          " << generator_search_us << " us, "
+              << parser_search_us / generator_search_us << "x\n"
+              << "    found at:           " << parser_found << " / " << generator_found << " ms\n"
+              << "  whole transcript\n"
+              << "    parse_buffer:       " << parser_full_us << " us\n"
+              << "    generator:          " << generator_full_us << " us, "
+              << generator_lines << " lines\n"
+              << std::flush;
+}
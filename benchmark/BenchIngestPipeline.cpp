@@ -0,0 +1,97 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Import of a mixed UTF-8 / GBK corpus: one thread doing read, decode, parse
+// and index per file, against LyricIngestPipeline with per-stage threads.
+#include "benchutils.h"
+#include <lyricingest.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    constexpr size_t file_count{400};
+
+    // 1. Corpus, every other file GBK encoded
+    const auto directory = std::filesystem::temp_directory_path() / "lp_bench_ingest";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        std::string bytes;
+        auto lines = LPBench::make_lrc(60, 3000, i % 3 == 0 ? 6 : 0);
+        for (size_t line = 2; line < lines.size(); ++line)
+        {
+            lines[line] += " 窗透初晓 日照西桥 云自摇";
+        }
+        for (const auto& line : lines)
+        {
+            bytes += line + "\n";
+        }
+        if (i % 2 == 1)
+        {
+            bytes = AudioToolKits::TextFileHelper::convert_encoding(bytes
+                                                                    , AudioToolKits::Encoding::UTF8
+                                                                    , AudioToolKits::Encoding::GBK);
+        }
+        paths.push_back((directory / ("song" + std::to_string(i) + ".lrc")).string());
+        std::ofstream{paths.back(), std::ios::binary} << bytes;
+    }
+    // 1.
+
+    // 2. Serial import
+    size_t serial_lines{0};
+    const auto begin = LPBench::Clock::now();
+    for (const auto& path : paths)
+    {
+        AudioToolKits::LyricParser parser{path};
+        if (!AudioToolKits::TextFileHelper::is_utf8(parser.get_lrc().back().m_text))
+        {
+            parser.change_encoding_utf8();
+        }
+        const AudioToolKits::LyricTimeline timeline{parser};
+        serial_lines += timeline.line_count();
+    }
+    const double serial_s = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e9;
+    std::cout << "serial:    " << file_count / serial_s << " files/s, "
+              << serial_lines << " lines\n";
+    // 2.
+
+    // 3. Pipeline
+    const size_t cores = std::max<unsigned>(std::thread::hardware_concurrency(), 2);
+    AudioToolKits::LyricIngestConfig config;
+    config.m_read_threads = 1;
+    config.m_decode_threads = 1;
+    config.m_parse_threads = std::max<size_t>(cores - 2, 1);
+    config.m_index_threads = 1;
+    config.m_queue_capacity = 32;
+    std::atomic<size_t> pipeline_lines{0};
+    AudioToolKits::LyricIngestPipeline pipeline{
+        config
+        , [&pipeline_lines](AudioToolKits::LyricIngestItem&& item)
+        {
+            pipeline_lines += item.m_timeline->line_count();
+        }
+    };
+    const auto stats = pipeline.run(paths);
+    std::cout << "pipeline:  " << file_count / stats.m_wall_seconds << " files/s, "
+              << pipeline_lines.load() << " lines\n";
+    for (size_t stage = 0; stage < AudioToolKits::LyricIngestPipeline::s_stage_count; ++stage)
+    {
+        const auto& s = stats.m_stages[stage];
+        std::printf("  %-7s threads %2zu  %8.1f items/s  utilization %5.2f  queue mean %5.1f max %3zu\n"
+                    , AudioToolKits::LyricIngestPipeline::stage_name(
+                        static_cast<AudioToolKits::LyricIngestPipeline::Stage>(stage))
+                    , s.m_threads
+                    , s.m_items_per_second
+                    , s.m_utilization
+                    , s.m_mean_queue_depth
+                    , s.m_max_queue_depth);
+    }
+    // 3.
+
+    std::filesystem::remove_all(directory);
+}
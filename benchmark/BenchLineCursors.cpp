@@ -0,0 +1,80 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// 100k listeners of one track: batched advance_cursors() against an
+// independent binary search per listener.
+#include "benchutils.h"
+#include <lyriccursor.h>
+#include <iostream>
+#include <random>
+
+int main()
+{
+    constexpr size_t listener_count{100000};
+    constexpr size_t line_count{80};
+    constexpr int64_t line_ms{3000};
+    constexpr int64_t push_interval_ms{250};
+
+    AudioToolKits::LyricParser parser;
+    parser.parse_lrc(LPBench::make_lrc(line_count, line_ms, 0));
+    const AudioToolKits::LyricTimeline timeline{parser};
+    const int64_t track_ms = static_cast<int64_t>(line_count) * line_ms;
+
+    // each listener joined at a different point of the track
+    std::mt19937_64 random{42};
+    std::uniform_int_distribution<int64_t> offset_dist{0, track_ms - 1};
+    std::vector<int64_t> offsets(listener_count);
+    for (auto& offset : offsets)
+    {
+        offset = offset_dist(random);
+    }
+
+    std::vector<AudioToolKits::LyricLineCursor> cursors(listener_count);
+    std::vector<uint32_t> naive_lines(listener_count);
+    std::vector<int64_t> positions(listener_count);
+    std::vector<uint8_t> changed(listener_count);
+    const size_t push_count = static_cast<size_t>(track_ms / push_interval_ms);
+
+    double batched_ns{0};
+    double naive_ns{0};
+    size_t changes{0};
+    for (size_t push = 0; push < push_count; ++push)
+    {
+        const int64_t now = static_cast<int64_t>(push) * push_interval_ms;
+        for (size_t i = 0; i < listener_count; ++i)
+        {
+            positions[i] = (offsets[i] + now) % track_ms;
+        }
+
+        auto begin = LPBench::Clock::now();
+        changes += AudioToolKits::advance_cursors(timeline
+                                                  , cursors.data()
+                                                  , positions.data()
+                                                  , listener_count
+                                                  , changed.data());
+        batched_ns += LPBench::elapsed_ns(begin, LPBench::Clock::now());
+
+        begin = LPBench::Clock::now();
+        for (size_t i = 0; i < listener_count; ++i)
+        {
+            naive_lines[i] = static_cast<uint32_t>(timeline.find_line(positions[i]));
+        }
+        naive_ns += LPBench::elapsed_ns(begin, LPBench::Clock::now());
+    }
+
+    size_t mismatches{0};
+    for (size_t i = 0; i < listener_count; ++i)
+    {
+        mismatches += cursors[i].m_line != naive_lines[i];
+    }
+
+    const double updates = static_cast<double>(listener_count * push_count);
+    std::cout << "listeners:              " << listener_count << "\n"
+              << "pushes:                 " << push_count << "\n"
+              << "cursor bytes:           " << sizeof(AudioToolKits::LyricLineCursor) << "\n"
+              << "batched ns/cursor:      " << batched_ns / updates << "\n"
+              << "binary search ns/query: " << naive_ns / updates << "\n"
+              << "batched updates/s:      " << updates / (batched_ns / 1e9) << "\n"
+              << "line changes:           " << changes << "\n"
+              << "mismatches:             " << mismatches << std::endl;
+}
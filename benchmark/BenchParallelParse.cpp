@@ -0,0 +1,53 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Parse of one large enhanced transcript held in memory, 16 hours of
+// [hh:mm:ss.xxx] stamps: the serial path against the chunked parse at 2, 4
+// and hardware threads.
+#include "benchutils.h"
+#include <lyricparser.h>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    constexpr size_t transcript_lines{40000};
+    constexpr int rounds{3};
+
+    const auto transcript = LPBench::make_lrc(transcript_lines, 1500, 4);
+    size_t bytes{0};
+    for (const auto& line : transcript)
+    {
+        bytes += line.size();
+    }
+
+    const auto run = [&transcript](const size_t threshold, const size_t threads, size_t& lines)
+    {
+        double best = 0;
+        for (int round = 0; round < rounds; ++round)
+        {
+            AudioToolKits::LyricParser parser;
+            parser.set_parallel_parse(threshold, threads);
+            const auto begin = LPBench::Clock::now();
+            parser.parse_lrc(transcript);
+            const double ns = LPBench::elapsed_ns(begin, LPBench::Clock::now());
+            best = round == 0 ? ns : std::min(best, ns);
+            lines = parser.line_count();
+        }
+        return best / 1e6;
+    };
+
+    size_t lines{0};
+    const double serial_ms = run(SIZE_MAX, 1, lines);
+    std::cout << "transcript:        " << transcript_lines << " lines, " << bytes / 1024 << " KiB\n"
+              << "hardware threads:  " << std::thread::hardware_concurrency() << "\n"
+              << "serial:            " << serial_ms << " ms (" << lines << " lines)\n";
+    for (const size_t threads : {size_t{2}, size_t{4}, size_t{0}})
+    {
+        const double chunked_ms = run(0, threads, lines);
+        std::cout << "chunked, " << (threads == 0 ? std::string{"hw"} : std::to_string(threads))
+                  << " threads: " << chunked_ms << " ms (" << lines << " lines), "
+                  << serial_ms / chunked_ms << "x\n";
+    }
+    std::cout << std::flush;
+}
@@ -0,0 +1,164 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Global heap allocations and wall time of LyricParser(path) over a corpus of
+// files, default allocator against a monotonic arena per file and per batch.
+#include "benchutils.h"
+#include <lyricparser.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+namespace
+{
+std::atomic<uint64_t> s_allocations{0};
+
+void* aligned_malloc(const std::size_t size, const std::size_t alignment)
+{
+#if defined (_WIN32) || defined(_WIN64)
+    return _aligned_malloc(size, alignment);
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void aligned_free(void* p)
+{
+#if defined (_WIN32) || defined(_WIN64)
+    _aligned_free(p);
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    std::free(p);
+#endif
+}
+}
+
+void* operator new(const std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned overloads
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = aligned_malloc(size == 0 ? 1 : size, static_cast<std::size_t>(alignment)))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    aligned_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    aligned_free(p);
+}
+
+int main()
+{
+    constexpr size_t file_count{200};
+    constexpr size_t batch_size{50};
+    constexpr size_t line_count{80};
+
+    // 1. Corpus, half standard and half enhanced lyrics with CJK lines
+    const auto directory = std::filesystem::temp_directory_path() / "lp_bench_alloc";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        auto lines = LPBench::make_lrc(line_count, 3000, i % 2 == 0 ? 0 : 6);
+        // past SSO, as most real CJK lines are
+        for (size_t line = 2; line < lines.size(); ++line)
+        {
+            lines[line] += " 窗外的麻雀在电线杆上多嘴";
+        }
+        paths.push_back((directory / ("song" + std::to_string(i) + ".lrc")).string());
+        std::ofstream out{paths.back(), std::ios::binary};
+        for (const auto& line : lines)
+        {
+            out << line << '\n';
+        }
+    }
+    // 1.
+
+    size_t checksum{0};
+    const auto run = [&checksum](const char* name, auto&& parse_all)
+    {
+        const uint64_t allocations_before = s_allocations.load();
+        const auto begin = LPBench::Clock::now();
+        parse_all();
+        const double ms = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e6;
+        const uint64_t allocations = s_allocations.load() - allocations_before;
+        std::cout << name << allocations << " allocations, "
+                  << allocations / file_count << " per file, " << ms << " ms\n";
+    };
+
+    // 2. Default allocator
+    run("default:        ", [&]()
+    {
+        for (const auto& path : paths)
+        {
+            const AudioToolKits::LyricParser parser{path};
+            checksum += parser.get_words().size();
+        }
+    });
+    // 2.
+
+    // 3. One arena per file
+    run("arena per file: ", [&]()
+    {
+        for (const auto& path : paths)
+        {
+            std::pmr::monotonic_buffer_resource arena{64 * 1024};
+            const AudioToolKits::LyricParser parser{path, &arena};
+            checksum += parser.get_words().size();
+        }
+    });
+    // 3.
+
+    // 4. One arena per batch, released after the batch
+    run("arena per batch:", [&]()
+    {
+        std::pmr::monotonic_buffer_resource arena{1024 * 1024};
+        for (size_t first = 0; first < paths.size(); first += batch_size)
+        {
+            {
+                std::vector<AudioToolKits::LyricParser> batch;
+                batch.reserve(batch_size);
+                for (size_t i = first; i < std::min(paths.size(), first + batch_size); ++i)
+                {
+                    batch.emplace_back(paths[i], &arena);
+                    checksum += batch.back().get_words().size();
+                }
+            }
+            arena.release();
+        }
+    });
+    // 4.
+
+    std::filesystem::remove_all(directory);
+    std::cout << "checksum:        " << checksum << std::endl;
+}
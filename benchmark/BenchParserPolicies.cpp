@@ -0,0 +1,121 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// LyricParseCore instantiations against LyricParser::parse_lrc() on a
+// standard and an enhanced corpus. The counting sink keeps nothing, so the
+// difference to parse_lrc() is the cost of building, sorting and timing
+// LyricLine results; the policy variants show the cost of detection, tag
+// capture and trimming.
+#include "benchutils.h"
+#include <lyricparser.h>
+#include <iostream>
+
+namespace
+{
+struct CountingSink
+{
+    size_t m_tags{0};
+
+    size_t m_lines{0};
+
+    size_t m_words{0};
+
+    size_t m_bytes{0};
+
+    void on_tag(const std::string_view key)
+    {
+        ++m_tags;
+        m_bytes += key.size();
+    }
+
+    void on_line_begin(int64_t)
+    {
+    }
+
+    void on_word(int64_t, uint32_t, std::string_view)
+    {
+        ++m_words;
+    }
+
+    void on_line_end(int64_t, const std::string_view text)
+    {
+        ++m_lines;
+        m_bytes += text.size();
+    }
+};
+
+constexpr int s_rounds{15};
+
+template <typename Parse>
+double best_us(const std::vector<std::vector<std::string>>& corpus, Parse&& parse)
+{
+    double best = 0;
+    for (int round = 0; round < s_rounds; ++round)
+    {
+        const auto begin = LPBench::Clock::now();
+        for (const auto& lrc : corpus)
+        {
+            parse(lrc);
+        }
+        const double us = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3 /
+                          static_cast<double>(corpus.size());
+        best = round == 0 ? us : std::min(best, us);
+    }
+    return best;
+}
+
+template <typename Format, typename Tags, typename Trim>
+double run_core(const std::vector<std::vector<std::string>>& corpus)
+{
+    CountingSink sink;
+    const double us = best_us(corpus
+                              , [&sink](const std::vector<std::string>& lrc)
+                              {
+                                  AudioToolKits::LyricParseCore<Format, Tags, Trim> core;
+                                  core.parse_text(core.parse_tags(lrc.begin(), lrc.end(), sink)
+                                                  , lrc.end()
+                                                  , sink);
+                              });
+    if (sink.m_lines == 0)
+    {
+        std::cerr << "no lines parsed" << std::endl;
+    }
+    return us;
+}
+}
+
+int main()
+{
+    using namespace AudioToolKits::LyricPolicy;
+    constexpr size_t song_count{200};
+
+    for (const size_t words : {size_t{0}, size_t{6}})
+    {
+        std::vector<std::vector<std::string>> corpus;
+        for (size_t i = 0; i < song_count; ++i)
+        {
+            corpus.push_back(LPBench::make_lrc(60, 3000, words));
+        }
+        const double parser_us = best_us(corpus
+                                         , [](const std::vector<std::string>& lrc)
+                                         {
+                                             AudioToolKits::LyricParser parser;
+                                             parser.parse_lrc(lrc);
+                                         });
+        const double auto_us = run_core<AutoFormat, CaptureTags, TrimText>(corpus);
+        const double fixed_us = words == 0
+                                    ? run_core<StandardFormat, CaptureTags, TrimText>(corpus)
+                                    : run_core<EnhancedFormat, CaptureTags, TrimText>(corpus);
+        const double lean_us = words == 0
+                                   ? run_core<StandardFormat, SkipTags, KeepText>(corpus)
+                                   : run_core<EnhancedFormat, SkipTags, KeepText>(corpus);
+
+        std::cout << (words == 0 ? "standard" : "enhanced") << " corpus, 60 lines per song\n"
+                  << "  LyricParser::parse_lrc:    " << parser_us << " us per song\n"
+                  << "  core auto/capture/trim:    " << auto_us << " us per song\n"
+                  << "  core fixed/capture/trim:   " << fixed_us << " us per song\n"
+                  << "  core fixed/skip/keep:      " << lean_us << " us per song, "
+                  << parser_us / lean_us << "x parse_lrc\n";
+    }
+    std::cout << std::flush;
+}
@@ -0,0 +1,77 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Cost of LyricPlaybackDispatcher::tick() as seen by an audio callback:
+// 48 kHz, 128-sample blocks, a UI thread draining the queue concurrently.
+#include "benchutils.h"
+#include <lyricdispatcher.h>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    constexpr uint32_t sample_rate{48000};
+    constexpr uint64_t block_size{128};
+    constexpr size_t line_count{600};
+    constexpr int64_t line_ms{4000};
+
+    AudioToolKits::LyricParser parser;
+    parser.parse_lrc(LPBench::make_lrc(line_count, line_ms, 8));
+    const auto timeline = std::make_shared<const AudioToolKits::LyricTimeline>(parser);
+    AudioToolKits::LyricPlaybackDispatcher dispatcher{timeline, sample_rate, 1024};
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> consumed{0};
+    std::thread ui_thread([&dispatcher, &stop, &consumed]()
+    {
+        AudioToolKits::LyricPlaybackEvent event;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            while (dispatcher.poll(event))
+            {
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    const uint64_t total_samples = static_cast<uint64_t>(line_count * line_ms) *
+                                   sample_rate / 1000;
+    const uint64_t tick_count = total_samples / block_size;
+
+    // 1. Mean cost, one clock read for the whole run
+    const auto begin = LPBench::Clock::now();
+    for (uint64_t i = 0; i < tick_count; ++i)
+    {
+        dispatcher.tick(i * block_size);
+    }
+    const double mean_ns = LPBench::elapsed_ns(begin, LPBench::Clock::now()) /
+                           static_cast<double>(tick_count);
+    // 1.
+
+    // 2. Tail latency, each tick timed on its own (includes clock overhead)
+    std::vector<double> samples;
+    samples.reserve(tick_count);
+    for (uint64_t i = 0; i < tick_count; ++i)
+    {
+        // every 10000 blocks jump back to exercise the seek path
+        const uint64_t position = i % 10000 == 9999 ? (i / 2) * block_size : i * block_size;
+        const auto tick_begin = LPBench::Clock::now();
+        dispatcher.tick(position);
+        samples.push_back(LPBench::elapsed_ns(tick_begin, LPBench::Clock::now()));
+    }
+    // 2.
+
+    stop.store(true);
+    ui_thread.join();
+
+    std::cout << "ticks per pass:   " << tick_count << "\n"
+              << "mean tick:        " << mean_ns << " ns\n"
+              << "p50 tick:         " << LPBench::percentile(samples, 0.50) << " ns\n"
+              << "p99 tick:         " << LPBench::percentile(samples, 0.99) << " ns\n"
+              << "p99.99 tick:      " << LPBench::percentile(samples, 0.9999) << " ns\n"
+              << "max tick:         " << LPBench::percentile(samples, 1.0) << " ns\n"
+              << "events consumed:  " << consumed.load() << "\n"
+              << "events dropped:   " << dispatcher.dropped_events() << std::endl;
+}
@@ -0,0 +1,105 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Time-to-main of a binary that links lyric_parser and includes its headers.
+// The benchmark re-launches itself: the parent reads the steady clock right
+// before spawning, the child reads it first thing in main and reports it
+// through a pipe. For reference, the cost of compiling the four std::regex
+// patterns the parser used to build during static initialization.
+#include "benchutils.h"
+#include <lyricparser.h>
+#include <cstring>
+#include <iostream>
+#include <regex>
+
+#if defined (_WIN32) || defined(_WIN64)
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace
+{
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        LPBench::Clock::now().time_since_epoch()).count();
+}
+
+double regex_compile_us(const int rounds)
+{
+    const auto begin = LPBench::Clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        const std::regex tag{R"(\[(.*)\])"};
+        const std::regex enhanced{R"(<([^>]+)>(.*?)(?=<|$))"};
+        const std::regex text{R"(\[(\d{1,7}):(\d{1,2})(?::(\d{1,2}))?\.(\d{2,3})(?:\.(\d{2,3}))?\](.*))"};
+        const std::regex time{R"((\d{1,7}):(\d{1,2})(?::(\d{1,2}))?\.(\d{2,3}))"};
+    }
+    return LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3 / rounds;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "--child") == 0)
+    {
+        std::cout << now_ns() << std::flush;
+        return 0;
+    }
+    // keeps the library linked in
+    if (AudioToolKits::LyricParser::time_to_ms("00:01.000") != 1000)
+    {
+        return 1;
+    }
+
+#if defined (_WIN32) || defined(_WIN64)
+    std::cout << "time-to-main:      not measured on Windows\n";
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    constexpr int launches{200};
+    std::vector<double> samples;
+    for (int i = 0; i < launches; ++i)
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            std::cerr << "pipe failed" << std::endl;
+            return 1;
+        }
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, fds[0]);
+        char child_flag[] = "--child";
+        char* child_argv[] = {argv[0], child_flag, nullptr};
+
+        pid_t pid;
+        const int64_t spawn_ns = now_ns();
+        const int error = posix_spawn(&pid, argv[0], &actions, nullptr, child_argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(fds[1]);
+        if (error != 0)
+        {
+            close(fds[0]);
+            std::cerr << "posix_spawn failed: " << std::strerror(error) << std::endl;
+            return 1;
+        }
+        std::string reply;
+        char buffer[64];
+        for (ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) > 0;)
+        {
+            reply.append(buffer, static_cast<size_t>(n));
+        }
+        close(fds[0]);
+        waitpid(pid, nullptr, 0);
+        samples.push_back(static_cast<double>(std::stoll(reply) - spawn_ns) / 1e3);
+    }
+    std::cout << "launches:          " << launches << "\n"
+              << "p50 time-to-main:  " << LPBench::percentile(samples, 0.50) << " us\n"
+              << "p90 time-to-main:  " << LPBench::percentile(samples, 0.90) << " us\n";
+#endif
+    std::cout << "former static regex compile: " << regex_compile_us(100) << " us per process"
+              << std::endl;
+}
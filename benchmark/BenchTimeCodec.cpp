@@ -0,0 +1,70 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Size and decode speed of LyricTimeCodec streams holding the line and word
+// times of a timeline, against raw int64_t arrays and parse_lrc().
+#include "benchutils.h"
+#include <lyrictimecodec.h>
+#include <lyrictimeline.h>
+#include <iostream>
+
+int main()
+{
+    constexpr size_t line_count{600};
+    constexpr int rounds{2000};
+
+    const auto lrc = LPBench::make_lrc(line_count, 3750, 8);
+    AudioToolKits::LyricParser parser;
+    parser.parse_lrc(lrc);
+    const AudioToolKits::LyricTimeline timeline{parser};
+
+    std::vector<int64_t> word_starts;
+    for (size_t word = 0; word < timeline.word_count(); ++word)
+    {
+        word_starts.push_back(timeline.word_start_ms(word));
+    }
+    const std::string lines = AudioToolKits::LyricTimeCodec::encode(timeline.line_starts());
+    const std::string words = AudioToolKits::LyricTimeCodec::encode(word_starts);
+    const size_t raw_bytes = (timeline.line_count() + timeline.word_count()) * sizeof(int64_t);
+    const size_t encoded_bytes = lines.size() + words.size();
+
+    // 1. Decode both streams
+    const AudioToolKits::LyricTimeView line_view{lines.data(), lines.size()};
+    const AudioToolKits::LyricTimeView word_view{words.data(), words.size()};
+    std::vector<int64_t> decoded;
+    decoded.reserve(timeline.line_count() + timeline.word_count());
+    int64_t checksum{0};
+    auto begin = LPBench::Clock::now();
+    for (int round = 0; round < rounds; ++round)
+    {
+        decoded.clear();
+        if (!line_view.decode(decoded) || !word_view.decode(decoded))
+        {
+            return 1;
+        }
+        checksum += decoded.back();
+    }
+    const double decode_ns = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / rounds;
+    // 1.
+
+    // 2. Parse the same document
+    begin = LPBench::Clock::now();
+    for (int round = 0; round < 5; ++round)
+    {
+        AudioToolKits::LyricParser reparsed;
+        reparsed.parse_lrc(lrc);
+        checksum += static_cast<int64_t>(reparsed.get_words().size());
+    }
+    const double parse_ns = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 5;
+    // 2.
+
+    const double values = static_cast<double>(timeline.line_count() + timeline.word_count());
+    std::cout << "timestamps:       " << values << "\n"
+              << "raw int64 bytes:  " << raw_bytes << "\n"
+              << "encoded bytes:    " << encoded_bytes << "\n"
+              << "reduction:        " << static_cast<double>(raw_bytes) / encoded_bytes << "x\n"
+              << "decode:           " << decode_ns / 1000.0 << " us per document, "
+              << values / decode_ns * 1000.0 << " M values/s\n"
+              << "parse_lrc:        " << parse_ns / 1000.0 << " us per document\n"
+              << "checksum:         " << checksum << std::endl;
+}
@@ -0,0 +1,101 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// A consumer that looks at every line once (here: counts lines and text
+// bytes) through LyricParser::parse_lrc() against the streaming visitor
+// entry points, which never build LyricLine objects.
+#include "benchutils.h"
+#include <lyricparser.h>
+#include <iostream>
+
+namespace
+{
+class CountingVisitor final : public AudioToolKits::LyricVisitor
+{
+public:
+    size_t m_lines{0};
+
+    size_t m_bytes{0};
+
+    void on_line_end(int64_t, const std::string_view text) override
+    {
+        ++m_lines;
+        m_bytes += text.size();
+    }
+};
+
+constexpr int s_rounds{15};
+
+template <typename Parse>
+double best_us(const size_t song_count, Parse&& parse)
+{
+    double best = 0;
+    for (int round = 0; round < s_rounds; ++round)
+    {
+        const auto begin = LPBench::Clock::now();
+        for (size_t i = 0; i < song_count; ++i)
+        {
+            parse(i);
+        }
+        const double us = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e3 /
+                          static_cast<double>(song_count);
+        best = round == 0 ? us : std::min(best, us);
+    }
+    return best;
+}
+}
+
+int main()
+{
+    constexpr size_t song_count{200};
+
+    for (const size_t words : {size_t{0}, size_t{6}})
+    {
+        std::vector<std::vector<std::string>> songs;
+        std::vector<std::string> buffers;
+        for (size_t i = 0; i < song_count; ++i)
+        {
+            songs.push_back(LPBench::make_lrc(60, 3000, words));
+            std::string buffer;
+            for (const auto& line : songs.back())
+            {
+                buffer += line + "\r\n";
+            }
+            buffers.push_back(std::move(buffer));
+        }
+
+        size_t parser_bytes{0};
+        const double parser_us = best_us(song_count
+                                         , [&songs, &parser_bytes](const size_t i)
+                                         {
+                                             AudioToolKits::LyricParser parser;
+                                             parser.parse_lrc(songs[i]);
+                                             for (const auto& line : parser.get_text())
+                                             {
+                                                 parser_bytes += line.m_text.size();
+                                             }
+                                         });
+        CountingVisitor lines_visitor;
+        const double visit_us = best_us(song_count
+                                        , [&songs, &lines_visitor](const size_t i)
+                                        {
+                                            AudioToolKits::LyricParser::visit_lrc(songs[i], lines_visitor);
+                                        });
+        CountingVisitor buffer_visitor;
+        const double buffer_us = best_us(song_count
+                                         , [&buffers, &buffer_visitor](const size_t i)
+                                         {
+                                             AudioToolKits::LyricParser::visit_buffer(buffers[i], buffer_visitor);
+                                         });
+
+        std::cout << (words == 0 ? "standard" : "enhanced") << " corpus, 60 lines per song\n"
+                  << "  parse_lrc + get_text:   " << parser_us << " us per song\n"
+                  << "  visit_lrc:              " << visit_us << " us per song, "
+                  << parser_us / visit_us << "x\n"
+                  << "  visit_buffer:           " << buffer_us << " us per song, "
+                  << parser_us / buffer_us << "x\n"
+                  << "  text bytes seen:        " << parser_bytes << " / " << lines_visitor.m_bytes
+                  << " / " << buffer_visitor.m_bytes << "\n";
+    }
+    std::cout << std::flush;
+}
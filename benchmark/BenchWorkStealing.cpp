@@ -0,0 +1,108 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Parse of a skewed corpus, many short songs and a few long transcripts:
+// static contiguous partitioning of the file list across threads against
+// LyricDirectoryParser on a LyricWorkStealingPool.
+#include "benchutils.h"
+#include <lyricscheduler.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+int main()
+{
+    constexpr size_t directory_count{20};
+    constexpr size_t songs_per_directory{100};
+    constexpr size_t transcript_count{4};
+    constexpr size_t transcript_lines{40000};
+    const size_t thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+
+    // 1. Corpus, transcripts sorted last as a directory listing often does
+    const auto root = std::filesystem::temp_directory_path() / "lp_bench_steal";
+    std::vector<std::string> paths;
+    const auto write = [&paths](const std::filesystem::path& path
+                                , const std::vector<std::string>& lines)
+    {
+        std::ofstream out{path, std::ios::binary};
+        for (const auto& line : lines)
+        {
+            out << line << '\n';
+        }
+        paths.push_back(path.string());
+    };
+    const auto song = LPBench::make_lrc(40, 4000, 0);
+    for (size_t d = 0; d < directory_count; ++d)
+    {
+        const auto directory = root / ("artist" + std::to_string(d));
+        std::filesystem::create_directories(directory);
+        for (size_t s = 0; s < songs_per_directory; ++s)
+        {
+            write(directory / ("song" + std::to_string(s) + ".lrc"), song);
+        }
+    }
+    const auto transcript = LPBench::make_lrc(transcript_lines, 1500, 0);
+    std::filesystem::create_directories(root / "zz_podcasts");
+    for (size_t t = 0; t < transcript_count; ++t)
+    {
+        write(root / "zz_podcasts" / ("episode" + std::to_string(t) + ".lrc"), transcript);
+    }
+    // 1.
+
+    // 2. Static partitioning
+    std::atomic<size_t> static_lines{0};
+    auto begin = LPBench::Clock::now();
+    {
+        std::vector<std::thread> threads;
+        const size_t per_thread = (paths.size() + thread_count - 1) / thread_count;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&paths, &static_lines, t, per_thread]()
+            {
+                for (size_t i = t * per_thread; i < std::min(paths.size(), (t + 1) * per_thread); ++i)
+                {
+                    const AudioToolKits::LyricParser parser{paths[i]};
+                    static_lines += parser.line_count();
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    const double static_ms = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e6;
+    // 2.
+
+    // 3. Work stealing, directory walk included
+    std::atomic<size_t> stolen_lines{0};
+    AudioToolKits::LyricWorkStealingPool pool{thread_count};
+    AudioToolKits::LyricDirectoryParser::Options options;
+    options.m_split_bytes = 256 * 1024;
+    options.m_split_lines = 4096;
+    AudioToolKits::LyricDirectoryParser parser{pool, options};
+    begin = LPBench::Clock::now();
+    parser.parse_tree(root
+                      , [&stolen_lines](AudioToolKits::LyricParsedFile&& file)
+                      {
+                          stolen_lines += file.m_document->line_count();
+                      });
+    pool.wait_idle();
+    const double steal_ms = LPBench::elapsed_ns(begin, LPBench::Clock::now()) / 1e6;
+    // 3.
+
+    const auto stats = pool.stats();
+    std::cout << "threads:          " << thread_count << " (" << std::thread::hardware_concurrency()
+              << " cores)\n"
+              << "static partition: " << static_ms << " ms, " << static_lines.load() << " lines\n"
+              << "work stealing:    " << steal_ms << " ms, " << stolen_lines.load() << " lines\n"
+              << "steals:           " << stats.m_steals << "\n"
+              << "tasks per worker:";
+    for (const auto executed : stats.m_executed)
+    {
+        std::cout << " " << executed;
+    }
+    std::cout << std::endl;
+    std::filesystem::remove_all(root);
+}
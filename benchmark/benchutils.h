@@ -0,0 +1,83 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace LPBench
+{
+using Clock = std::chrono::steady_clock;
+
+inline double elapsed_ns(const Clock::time_point begin, const Clock::time_point end)
+{
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+// mm:ss.xxx, hh:mm:ss.xxx from one hour on
+inline std::string format_ms(const int64_t ms)
+{
+    char buffer[32];
+    if (ms >= 3600000)
+    {
+        std::snprintf(buffer
+                      , sizeof(buffer)
+                      , "%02lld:%02lld:%02lld.%03lld"
+                      , static_cast<long long>(ms / 3600000)
+                      , static_cast<long long>(ms / 60000 % 60)
+                      , static_cast<long long>(ms / 1000 % 60)
+                      , static_cast<long long>(ms % 1000));
+        return buffer;
+    }
+    std::snprintf(buffer
+                  , sizeof(buffer)
+                  , "%02lld:%02lld.%03lld"
+                  , static_cast<long long>(ms / 60000)
+                  , static_cast<long long>(ms / 1000 % 60)
+                  , static_cast<long long>(ms % 1000));
+    return buffer;
+}
+
+// synthetic LRC, one line every line_ms, enhanced lines get words_per_line word stamps
+inline std::vector<std::string> make_lrc(const size_t line_count
+                                         , const int64_t line_ms
+                                         , const size_t words_per_line)
+{
+    std::vector<std::string> lines{"[ar: Benchmark]", "[ti: Synthetic]"};
+    lines.reserve(line_count + 2);
+    for (size_t i = 0; i < line_count; ++i)
+    {
+        const int64_t start = static_cast<int64_t>(i) * line_ms;
+        std::string line = "[" + format_ms(start) + "]";
+        if (words_per_line == 0)
+        {
+            line += " line number " + std::to_string(i) + " of the synthetic lyric";
+        }
+        for (size_t w = 0; w < words_per_line; ++w)
+        {
+            const int64_t word_ms = start +
+                                    static_cast<int64_t>(w) * line_ms /
+                                    static_cast<int64_t>(words_per_line);
+            line += " <" + format_ms(word_ms) + "> word" + std::to_string(w);
+        }
+        lines.emplace_back(std::move(line));
+    }
+    return lines;
+}
+
+inline double percentile(std::vector<double> samples, const double fraction)
+{
+    if (samples.empty())
+    {
+        return 0.0;
+    }
+    const auto index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+}
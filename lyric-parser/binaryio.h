@@ -0,0 +1,106 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+// Little-endian helpers shared by the compiled lyric formats, private to the library.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace AudioToolKits::BinaryIO
+{
+inline void put_u16(std::string& out, const uint16_t value)
+{
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+inline void put_u32(std::string& out, const uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+inline void put_u64(std::string& out, const uint64_t value)
+{
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+inline void put_i64(std::string& out, const int64_t value)
+{
+    put_u64(out, static_cast<uint64_t>(value));
+}
+
+inline void patch_u16(std::string& out, const size_t pos, const uint16_t value)
+{
+    out[pos] = static_cast<char>(value & 0xFF);
+    out[pos + 1] = static_cast<char>((value >> 8) & 0xFF);
+}
+
+inline void patch_u32(std::string& out, const size_t pos, const uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out[pos + i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+    }
+}
+
+inline void patch_u64(std::string& out, const size_t pos, const uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        out[pos + i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+    }
+}
+
+inline void align_to(std::string& out, const size_t alignment)
+{
+    while (out.size() % alignment != 0)
+    {
+        out.push_back('\0');
+    }
+}
+
+inline uint64_t fnv1a(const std::string_view bytes)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : bytes)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// byte-wise loads compile to a single mov on little-endian targets
+inline uint16_t load_u16(const char* p)
+{
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<uint16_t>(b[0] | (b[1] << 8));
+}
+
+inline uint32_t load_u32(const char* p)
+{
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<uint32_t>(b[0]) |
+           (static_cast<uint32_t>(b[1]) << 8) |
+           (static_cast<uint32_t>(b[2]) << 16) |
+           (static_cast<uint32_t>(b[3]) << 24);
+}
+
+inline uint64_t load_u64(const char* p)
+{
+    return static_cast<uint64_t>(load_u32(p)) |
+           (static_cast<uint64_t>(load_u32(p + 4)) << 32);
+}
+
+inline int64_t load_i64(const char* p)
+{
+    return static_cast<int64_t>(load_u64(p));
+}
+}
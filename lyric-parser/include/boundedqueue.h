@@ -0,0 +1,111 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace AudioToolKits
+{
+// Blocking multi-producer multi-consumer FIFO with a fixed capacity. push()
+// waits while the queue is full, which throttles faster producers (backpressure).
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(const size_t capacity)
+        : m_capacity{capacity == 0 ? 1 : capacity}
+    {
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+
+    BoundedQueue(BoundedQueue&&) = delete;
+
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+    ~BoundedQueue() = default;
+
+    // false once the queue is closed, value is dropped; depth receives the
+    // number of queued items after the push
+    bool push(T&& value, size_t* depth = nullptr)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [this]()
+        {
+            return m_closed || m_items.size() < m_capacity;
+        });
+        if (m_closed)
+        {
+            return false;
+        }
+        m_items.push_back(std::move(value));
+        if (depth != nullptr)
+        {
+            *depth = m_items.size();
+        }
+        lock.unlock();
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    // waits for an item, empty once the queue is closed and drained
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this]()
+        {
+            return m_closed || !m_items.empty();
+        });
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(m_items.front())};
+        m_items.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return value;
+    }
+
+    // wakes every waiter, queued items can still be popped
+    void close()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.size();
+    }
+
+    [[nodiscard]] size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    const size_t m_capacity;
+
+    mutable std::mutex m_mutex;
+
+    std::condition_variable m_not_empty;
+
+    std::condition_variable m_not_full;
+
+    std::deque<T> m_items;
+
+    bool m_closed{false};
+};
+}
@@ -0,0 +1,114 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace AudioToolKits
+{
+class LyricWorkStealingPool;
+
+// Shared flag between the caller and the load it started, copies see the same
+// state. A track skip cancels the token of the previous track.
+class LyricCancelToken
+{
+public:
+    LyricCancelToken();
+
+    void cancel() const;
+
+    [[nodiscard]] bool is_cancelled() const;
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+enum class LyricLoadStatus
+{
+    Loaded,
+    // nothing could be read or parsed, or the load threw
+    Failed,
+    // the token was cancelled before the result was delivered
+    Cancelled
+};
+
+struct LyricLoadResult
+{
+    LyricLoadStatus m_status{LyricLoadStatus::Failed};
+
+    // null unless Loaded
+    LyricDocument m_document;
+
+    [[nodiscard]] bool loaded() const
+    {
+        return m_status == LyricLoadStatus::Loaded;
+    }
+};
+
+// Reads, decodes and parses lyrics on a work executor so the calling thread
+// (e.g. a UI thread) only pays for queueing the task. Results come back as a
+// std::future or through a callback posted to a caller-provided executor.
+// The token is checked before the read, before the parse and, for callbacks,
+// on the callback executor right before the call, so a cancelled load never
+// delivers a document.
+//
+//   m_token.cancel();
+//   m_token = {};
+//   loader.load_file(path, m_token, post_to_ui, [this](LyricLoadResult&& result)
+//   {
+//       if (result.loaded()) { m_snapshot.publish(std::move(result.m_document)); }
+//   });
+class LyricAsyncLoader
+{
+public:
+    using Task = std::function<void()>;
+
+    using Executor = std::function<void(Task)>;
+
+    using Callback = std::function<void(LyricLoadResult&&)>;
+
+    // work_executor runs the loads, it and the pool must outlive pending loads
+    explicit LyricAsyncLoader(Executor work_executor);
+
+    explicit LyricAsyncLoader(LyricWorkStealingPool& pool);
+
+    // GBK files are converted to UTF-8 first, as LyricParser::visit_file() does;
+    // unlike LyricParser(file_path), which keeps the raw bytes until
+    // change_encoding_utf8(). A load that throws rethrows from the future and
+    // reaches a callback as Failed.
+    std::future<LyricLoadResult> load_file(std::string file_path, LyricCancelToken token = {});
+
+    void load_file(std::string file_path
+                   , LyricCancelToken token
+                   , Executor callback_executor
+                   , Callback callback);
+
+    // an in-memory UTF-8 file, see LyricParser::parse_buffer()
+    std::future<LyricLoadResult> parse_buffer(std::string utf8_bytes, LyricCancelToken token = {});
+
+    void parse_buffer(std::string utf8_bytes
+                      , LyricCancelToken token
+                      , Executor callback_executor
+                      , Callback callback);
+
+    // the work the loaders above run, on the calling thread
+    static LyricLoadResult load_file_now(const std::string& file_path, const LyricCancelToken& token);
+
+    static LyricLoadResult parse_buffer_now(std::string_view utf8_bytes, const LyricCancelToken& token);
+
+private:
+    std::future<LyricLoadResult> submit(std::function<LyricLoadResult()> work);
+
+    void submit(std::function<LyricLoadResult()> work
+                , LyricCancelToken token
+                , Executor callback_executor
+                , Callback callback);
+
+    Executor m_work_executor;
+};
+}
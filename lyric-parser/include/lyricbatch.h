@@ -0,0 +1,54 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyriccursor.h>
+#include <lyrictimeline.h>
+#include <cstdint>
+#include <vector>
+
+namespace AudioToolKits
+{
+struct LyricTimeQuery
+{
+    // index into the documents passed to LyricBatchResolver
+    uint32_t m_document{0};
+
+    int64_t m_time_ms{0};
+};
+
+// Resolves many (document, time) queries to line indices at once.
+// Queries are bucketed by document so each timeline is hot in cache while its
+// queries run, buckets already in time order are answered with one galloping
+// merge, the rest with a branchless binary search.
+// Scratch buffers are kept between calls, one resolver per thread.
+class LyricBatchResolver
+{
+public:
+    explicit LyricBatchResolver(std::vector<const LyricTimeline*> documents);
+
+    // lines[i] answers queries[i], LyricLineCursor::s_none before the first
+    // line or for an unknown document
+    void resolve(const std::vector<LyricTimeQuery>& queries
+                 , std::vector<uint32_t>& lines);
+
+    [[nodiscard]] size_t document_count() const
+    {
+        return m_documents.size();
+    }
+
+private:
+    static void merge_sorted(const std::vector<int64_t>& starts
+                             , const std::vector<LyricTimeQuery>& queries
+                             , std::vector<uint32_t>::const_iterator begin
+                             , std::vector<uint32_t>::const_iterator end
+                             , std::vector<uint32_t>& lines);
+
+    std::vector<const LyricTimeline*> m_documents;
+
+    // query indices grouped by document, m_bucket_begin has document_count() + 1 entries
+    std::vector<uint32_t> m_order;
+
+    std::vector<uint32_t> m_bucket_begin;
+};
+}
@@ -0,0 +1,164 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <mappedfile.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AudioToolKits
+{
+// Compiled lyric layout, version 1, all integers little-endian, sections 8-byte aligned:
+//   header   64 bytes, see LyricBinaryView::HeaderField
+//   tags     tag_count  x {u32 pool offset, u32 length}
+//   times    line_count x i64 start ms
+//   lines    line_count x {u32 pool offset, u32 length}
+//   words    word_count x {i64 start ms, u32 line, u32 offset in line, u32 length, u32 0}
+//   seek     seek_count x u32, lines starting at or before k * seek_step_ms
+//   pool     UTF-8 bytes of every tag and line
+class LyricCompiler
+{
+public:
+    static std::string compile(const LyricParser& parser);
+
+    static bool compile_to_file(const LyricParser& parser
+                                , std::string_view file_path);
+};
+
+// Zero-copy query API over a compiled lyric held in memory.
+class LyricBinaryView
+{
+public:
+    static constexpr char s_magic[4]{'L', 'R', 'C', 'B'};
+
+    static constexpr uint16_t s_version{1};
+
+    static constexpr size_t s_header_size{64};
+
+    enum Flags : uint16_t
+    {
+        Enhanced = 1 << 0,
+        // times are non-decreasing, the seek index is usable
+        Sorted = 1 << 1
+    };
+
+    enum HeaderField : size_t
+    {
+        Magic = 0,
+        Version = 4,
+        FlagBits = 6,
+        HeaderSize = 8,
+        TagCount = 12,
+        LineCount = 16,
+        WordCount = 20,
+        SeekStepMs = 24,
+        SeekCount = 28,
+        TagsOffset = 32,
+        TimesOffset = 36,
+        LinesOffset = 40,
+        WordsOffset = 44,
+        SeekOffset = 48,
+        PoolOffset = 52,
+        PoolSize = 56,
+        TotalSize = 60
+    };
+
+    LyricBinaryView() = default;
+
+    LyricBinaryView(const char* data, size_t size);
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]] bool is_enhanced() const;
+
+    [[nodiscard]] size_t tag_count() const
+    {
+        return m_tag_count;
+    }
+
+    [[nodiscard]] std::string_view tag(size_t index) const;
+
+    [[nodiscard]] size_t line_count() const
+    {
+        return m_line_count;
+    }
+
+    [[nodiscard]] int64_t start_ms(size_t index) const;
+
+    [[nodiscard]] std::string_view text(size_t index) const;
+
+    [[nodiscard]] size_t word_count() const
+    {
+        return m_word_count;
+    }
+
+    [[nodiscard]] LyricWord word(size_t index) const;
+
+    // index of the line shown at time_ms, none before the first line
+    [[nodiscard]] std::optional<size_t> find_line(int64_t time_ms) const;
+
+    [[nodiscard]] std::vector<std::string> get_tags() const;
+
+    [[nodiscard]] std::vector<LyricLine> get_text() const;
+
+    [[nodiscard]] const char* data() const
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    [[nodiscard]] std::string_view pool_string(const char* entry) const;
+
+    const char* m_data{nullptr};
+
+    size_t m_size{0};
+
+    uint16_t m_flags{0};
+
+    uint32_t m_tag_count{0};
+
+    uint32_t m_line_count{0};
+
+    uint32_t m_word_count{0};
+
+    uint32_t m_seek_step_ms{0};
+
+    uint32_t m_seek_count{0};
+
+    const char* m_tags{nullptr};
+
+    const char* m_times{nullptr};
+
+    const char* m_lines{nullptr};
+
+    const char* m_words{nullptr};
+
+    const char* m_seek{nullptr};
+
+    const char* m_pool{nullptr};
+
+    uint32_t m_pool_size{0};
+};
+
+// Maps a compiled lyric file read-only and exposes it as a LyricBinaryView.
+class LyricBinaryReader : public LyricBinaryView
+{
+public:
+    explicit LyricBinaryReader(std::string_view file_path);
+
+private:
+    MappedFile m_file;
+};
+}
@@ -0,0 +1,137 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AudioToolKits
+{
+struct LyricCacheStats
+{
+    uint64_t m_hits{0};
+
+    uint64_t m_misses{0};
+
+    uint64_t m_evictions{0};
+
+    // number of parses actually performed, concurrent misses share one load
+    uint64_t m_loads{0};
+
+    size_t m_entries{0};
+
+    size_t m_bytes{0};
+};
+
+// Thread-safe sharded LRU cache of parsed lyric documents.
+// Documents are shared as immutable LyricParser objects, the byte budget is
+// split evenly across shards and charged with LyricParser::memory_usage().
+class LyricCache
+{
+public:
+    using Document = LyricDocument;
+
+    explicit LyricCache(size_t byte_budget, size_t shard_count = 16);
+
+    LyricCache(const LyricCache&) = delete;
+
+    LyricCache(LyricCache&&) = delete;
+
+    LyricCache& operator=(const LyricCache&) = delete;
+
+    LyricCache& operator=(LyricCache&&) = delete;
+
+    ~LyricCache();
+
+    // keyed by path, a cached entry is reused only while mtime and size match
+    Document get_file(std::string_view file_path);
+
+    // keyed by a 64-bit hash of the lines
+    Document get_content(const std::vector<std::string>& file_content);
+
+    void erase_file(std::string_view file_path);
+
+    void clear();
+
+    [[nodiscard]] LyricCacheStats stats() const;
+
+    [[nodiscard]] size_t byte_budget() const;
+
+    static uint64_t content_hash(const std::vector<std::string>& file_content);
+
+private:
+    struct FileStamp
+    {
+        std::filesystem::file_time_type m_mtime{};
+
+        uintmax_t m_size{0};
+
+        bool operator==(const FileStamp& other) const
+        {
+            return m_mtime == other.m_mtime && m_size == other.m_size;
+        }
+    };
+
+    struct Entry
+    {
+        std::string m_key;
+
+        FileStamp m_stamp;
+
+        Document m_document;
+
+        size_t m_bytes{0};
+    };
+
+    struct Shard
+    {
+        mutable std::mutex m_mutex;
+
+        std::list<Entry> m_lru;
+
+        std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+
+        std::unordered_map<std::string, std::shared_future<Document>> m_loading;
+
+        size_t m_bytes{0};
+
+        uint64_t m_hits{0};
+
+        uint64_t m_misses{0};
+
+        uint64_t m_evictions{0};
+
+        uint64_t m_loads{0};
+    };
+
+    template <typename Loader>
+    Document get_or_load(const std::string& key
+                         , const FileStamp& stamp
+                         , Loader&& loader);
+
+    Shard& shard_for(const std::string& key);
+
+    void insert_locked(Shard& shard
+                       , const std::string& key
+                       , const FileStamp& stamp
+                       , const Document& document);
+
+    static void erase_locked(Shard& shard
+                             , std::list<Entry>::iterator it);
+
+    size_t m_byte_budget;
+
+    size_t m_shard_budget;
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+}
@@ -0,0 +1,89 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AudioToolKits
+{
+// 12-byte LyricLine for resident corpora, the text lives in the string pool of
+// the LyricCompactStore that owns the line.
+struct LyricCompactLine
+{
+    // m_start_ms of a tag line
+    static constexpr uint32_t s_tag{UINT32_MAX};
+
+    uint32_t m_start_ms{s_tag};
+
+    uint32_t m_offset{0};
+
+    uint32_t m_length{0};
+
+    [[nodiscard]] bool isTag() const
+    {
+        return m_start_ms == s_tag;
+    }
+
+    [[nodiscard]] bool isText() const
+    {
+        return m_start_ms != s_tag;
+    }
+
+    [[nodiscard]] int64_t start_ms() const
+    {
+        return m_start_ms;
+    }
+};
+
+// Append-only store of many documents, one shared string pool and one line
+// array, 4 bytes of bookkeeping per document. Repeated lines of a document
+// are pooled once. Offsets are 32-bit, so a store holds at most 4 GiB of
+// text; shard larger corpora over several stores.
+class LyricCompactStore
+{
+public:
+    static constexpr uint32_t npos{UINT32_MAX};
+
+    LyricCompactStore();
+
+    // appends the lines of a document, returns its id or npos when a time
+    // does not fit in 32 bits or the pool would exceed 4 GiB
+    [[nodiscard]] uint32_t add(const std::vector<LyricLine>& lines);
+
+    [[nodiscard]] uint32_t add(const LyricParser& parser);
+
+    [[nodiscard]] size_t document_count() const
+    {
+        return m_first_line.size() - 1;
+    }
+
+    [[nodiscard]] size_t line_count(uint32_t document) const;
+
+    [[nodiscard]] const LyricCompactLine& line(uint32_t document
+                                               , size_t index) const;
+
+    [[nodiscard]] std::string_view text(const LyricCompactLine& line) const;
+
+    // the document as get_lrc() returned it
+    [[nodiscard]] std::vector<LyricLine> lines(uint32_t document) const;
+
+    void shrink_to_fit();
+
+    [[nodiscard]] size_t memory_usage() const;
+
+    // heap and inline bytes of a LyricLine vector, SSO strings are not counted twice
+    [[nodiscard]] static size_t memory_usage(const std::vector<LyricLine>& lines);
+
+private:
+    std::vector<LyricCompactLine> m_lines;
+
+    // document_count() + 1 entries
+    std::vector<uint32_t> m_first_line;
+
+    std::string m_pool;
+};
+}
@@ -0,0 +1,38 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyrictimeline.h>
+#include <cstdint>
+#include <vector>
+
+namespace AudioToolKits
+{
+// Current line of one listener over a shared LyricTimeline, 4 bytes so large
+// listener arrays stay dense.
+struct LyricLineCursor
+{
+    static constexpr uint32_t s_none{UINT32_MAX};
+
+    uint32_t m_line{s_none};
+
+    [[nodiscard]] bool has_line() const
+    {
+        return m_line != s_none;
+    }
+};
+
+// Moves cursors[i] to the line shown at positions_ms[i] in one pass.
+// changed, when not null, receives 1 for every cursor whose line moved.
+// Returns the number of cursors that changed line.
+size_t advance_cursors(const LyricTimeline& timeline
+                       , LyricLineCursor* cursors
+                       , const int64_t* positions_ms
+                       , size_t count
+                       , uint8_t* changed = nullptr);
+
+size_t advance_cursors(const LyricTimeline& timeline
+                       , std::vector<LyricLineCursor>& cursors
+                       , const std::vector<int64_t>& positions_ms
+                       , std::vector<uint8_t>* changed = nullptr);
+}
@@ -0,0 +1,90 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyrictimeline.h>
+#include <spscqueue.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace AudioToolKits
+{
+struct LyricPlaybackEvent
+{
+    enum class Type : uint8_t
+    {
+        LineChanged, WordChanged, Seek
+    };
+
+    Type m_type{Type::LineChanged};
+
+    // LyricTimeline::npos when nothing is active
+    size_t m_line{LyricTimeline::npos};
+
+    size_t m_word{LyricTimeline::npos};
+
+    int64_t m_time_ms{0};
+};
+
+// Turns the playback position reported by a real-time audio thread into line
+// and word change events for a UI thread.
+// tick() neither locks nor allocates, events travel through a bounded SPSC
+// queue and are dropped (and counted) when the consumer falls behind.
+class LyricPlaybackDispatcher
+{
+public:
+    LyricPlaybackDispatcher(std::shared_ptr<const LyricTimeline> timeline
+                            , uint32_t sample_rate
+                            , size_t queue_capacity = 256);
+
+    LyricPlaybackDispatcher(const LyricPlaybackDispatcher&) = delete;
+
+    LyricPlaybackDispatcher(LyricPlaybackDispatcher&&) = delete;
+
+    LyricPlaybackDispatcher& operator=(const LyricPlaybackDispatcher&) = delete;
+
+    LyricPlaybackDispatcher& operator=(LyricPlaybackDispatcher&&) = delete;
+
+    ~LyricPlaybackDispatcher();
+
+    // audio thread only, sample_position counts samples of the source media so
+    // playback speed changes need no extra handling, backward or large forward
+    // jumps are reported as Seek
+    void tick(uint64_t sample_position) noexcept;
+
+    // any thread, applies from the next tick
+    void set_sample_rate(uint32_t sample_rate) noexcept;
+
+    // consumer thread only
+    bool poll(LyricPlaybackEvent& event) noexcept;
+
+    [[nodiscard]] uint64_t dropped_events() const noexcept;
+
+    [[nodiscard]] const LyricTimeline& timeline() const
+    {
+        return *m_timeline;
+    }
+
+private:
+    // forward moves longer than this many lines are resolved by binary search
+    static constexpr size_t s_max_linear_steps{4};
+
+    void push(LyricPlaybackEvent::Type type, int64_t time_ms) noexcept;
+
+    std::shared_ptr<const LyricTimeline> m_timeline;
+
+    SpscQueue<LyricPlaybackEvent> m_queue;
+
+    std::atomic<uint32_t> m_sample_rate;
+
+    std::atomic<uint64_t> m_dropped{0};
+
+    // owned by the audio thread
+    int64_t m_last_ms{-1};
+
+    size_t m_line{LyricTimeline::npos};
+
+    size_t m_word{LyricTimeline::npos};
+};
+}
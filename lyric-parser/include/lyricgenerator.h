@@ -0,0 +1,286 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <textfilehelper.h>
+
+// C++20 only, the rest of the library stays C++17
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && __has_include(<span>)
+#define LYRIC_PARSER_HAS_GENERATOR 1
+#include <coroutine>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <span>
+#include <utility>
+
+namespace AudioToolKits
+{
+// One parsed tag or text line, borrowed from the generator until it resumes.
+struct LyricLineView
+{
+    // none for a tag
+    std::optional<int64_t> m_start_ms;
+
+    std::string_view m_text;
+
+    // enhanced lines, m_line is the index among the text lines yielded so far
+    std::span<const LyricWord> m_words;
+
+    [[nodiscard]] bool isTag() const
+    {
+        return !m_start_ms.has_value();
+    }
+
+    [[nodiscard]] bool isText() const
+    {
+        return m_start_ms.has_value();
+    }
+
+    [[nodiscard]] int64_t start_ms() const
+    {
+        return m_start_ms.value();
+    }
+};
+
+// Lazy parse_lrc(): lines are parsed by LyricParser::ParseCore one at a time as
+// the consumer iterates, in input order, and stop where parse_lrc() stops.
+// Breaking out of the loop leaves the rest of the input untouched. An exception
+// thrown while parsing (e.g. std::bad_alloc) ends the generator and is rethrown
+// from begin() or operator++.
+//
+//   for (const auto& line : LyricLineGenerator::from_buffer(bytes)) { ... }
+class LyricLineGenerator
+{
+public:
+    struct promise_type
+    {
+        const LyricLineView* m_current{nullptr};
+
+        std::exception_ptr m_exception;
+
+        LyricLineGenerator get_return_object()
+        {
+            return LyricLineGenerator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always yield_value(const LyricLineView& line) noexcept
+        {
+            m_current = &line;
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            m_exception = std::current_exception();
+        }
+
+        // the coroutine is finished after a throw, the exception is handed out once
+        void rethrow_if_failed()
+        {
+            if (m_exception)
+            {
+                std::rethrow_exception(std::exchange(m_exception, nullptr));
+            }
+        }
+    };
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = LyricLineView;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        explicit iterator(const std::coroutine_handle<promise_type> handle)
+            : m_handle{handle}
+        {
+        }
+
+        const LyricLineView& operator*() const
+        {
+            return *m_handle.promise().m_current;
+        }
+
+        const LyricLineView* operator->() const
+        {
+            return m_handle.promise().m_current;
+        }
+
+        iterator& operator++()
+        {
+            m_handle.resume();
+            m_handle.promise().rethrow_if_failed();
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const
+        {
+            return !m_handle || m_handle.done();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    LyricLineGenerator(const LyricLineGenerator&) = delete;
+
+    LyricLineGenerator& operator=(const LyricLineGenerator&) = delete;
+
+    LyricLineGenerator(LyricLineGenerator&& other) noexcept
+        : m_handle{std::exchange(other.m_handle, {})}
+    {
+    }
+
+    LyricLineGenerator& operator=(LyricLineGenerator&& other) noexcept
+    {
+        std::swap(m_handle, other.m_handle);
+        return *this;
+    }
+
+    ~LyricLineGenerator()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    // parses up to the first line
+    iterator begin()
+    {
+        if (m_handle)
+        {
+            m_handle.resume();
+            m_handle.promise().rethrow_if_failed();
+        }
+        return iterator{m_handle};
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return {};
+    }
+
+    // lines must outlive the generator
+    template <typename Iterator>
+    static LyricLineGenerator from_range(Iterator o_it, const Iterator end)
+    {
+        LyricParser::ParseCore core;
+        Capture sink;
+        bool in_tags = true;
+        for (; o_it != end; ++o_it)
+        {
+            const auto next = std::next(o_it);
+            if (in_tags && core.parse_tags(o_it, next, sink) != o_it)
+            {
+                co_yield sink.m_line;
+                continue;
+            }
+            in_tags = false;
+            if (core.parse_text(o_it, next, sink) == o_it)
+            {
+                co_return;
+            }
+            co_yield sink.m_line;
+        }
+    }
+
+    static LyricLineGenerator from_lines(const std::vector<std::string>& file_content)
+    {
+        return from_range(file_content.begin(), file_content.end());
+    }
+
+    // utf8_bytes must outlive the generator
+    static LyricLineGenerator from_buffer(const std::string_view utf8_bytes)
+    {
+        const LyricBufferLines lines{utf8_bytes};
+        return from_range(lines.begin(), lines.end());
+    }
+
+    // reads and decodes the whole file on the first step, parses lazily
+    static LyricLineGenerator from_file(std::filesystem::path file_path)
+    {
+        std::string bytes;
+        if (!TextFileHelper::read_bytes(file_path, bytes))
+        {
+            co_return;
+        }
+        if (!TextFileHelper::is_utf8(bytes))
+        {
+            bytes = TextFileHelper::convert_encoding(bytes, Encoding::GBK, Encoding::UTF8);
+        }
+        for (const auto& line : from_buffer(bytes))
+        {
+            co_yield line;
+        }
+    }
+
+private:
+    // the last event of the core, words are kept until the next line begins
+    struct Capture
+    {
+        LyricLineView m_line;
+
+        std::vector<LyricWord> m_words;
+
+        uint32_t m_line_index{0};
+
+        void on_tag(const std::string_view key)
+        {
+            m_line = LyricLineView{std::nullopt, key, {}};
+        }
+
+        void on_line_begin(int64_t)
+        {
+            m_words.clear();
+        }
+
+        void on_word(const int64_t start_ms, const uint32_t offset, const std::string_view text)
+        {
+            m_words.push_back(LyricWord{start_ms
+                                        , m_line_index
+                                        , offset
+                                        , static_cast<uint32_t>(text.size())});
+        }
+
+        void on_line_end(const int64_t start_ms, const std::string_view text)
+        {
+            m_line = LyricLineView{start_ms, text, m_words};
+            ++m_line_index;
+        }
+    };
+
+    explicit LyricLineGenerator(const std::coroutine_handle<promise_type> handle)
+        : m_handle{handle}
+    {
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+}
+#else
+#define LYRIC_PARSER_HAS_GENERATOR 0
+#endif
@@ -0,0 +1,153 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <lyrictimeline.h>
+#include <textfilehelper.h>
+#include <boundedqueue.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace AudioToolKits
+{
+// One file travelling through LyricIngestPipeline, each stage fills its part
+// and releases what later stages no longer need.
+struct LyricIngestItem
+{
+    std::string m_path;
+
+    // raw file, released by the decode stage
+    std::string m_bytes;
+
+    // UTF-8 lines, released by the parse stage
+    std::vector<std::string> m_lines;
+
+    Encoding m_encoding{Encoding::UNKNOWN};
+
+    LyricDocument m_document;
+
+    std::shared_ptr<const LyricTimeline> m_timeline;
+};
+
+struct LyricIngestConfig
+{
+    size_t m_read_threads{2};
+
+    size_t m_decode_threads{1};
+
+    size_t m_parse_threads{2};
+
+    size_t m_index_threads{1};
+
+    // capacity of the queue in front of every stage
+    size_t m_queue_capacity{64};
+};
+
+struct LyricStageStats
+{
+    size_t m_threads{0};
+
+    uint64_t m_items{0};
+
+    uint64_t m_errors{0};
+
+    // summed over the stage threads
+    double m_busy_seconds{0.0};
+
+    // items completed per second of pipeline wall time
+    double m_items_per_second{0.0};
+
+    // busy time over threads x wall time, 1 means the stage is the bottleneck
+    double m_utilization{0.0};
+
+    // depth of the input queue sampled at every push
+    size_t m_max_queue_depth{0};
+
+    double m_mean_queue_depth{0.0};
+};
+
+struct LyricIngestStats
+{
+    std::array<LyricStageStats, 4> m_stages{};
+
+    double m_wall_seconds{0.0};
+};
+
+// Staged import: read, decode (GBK to UTF-8), parse and index run on their own
+// threads, connected by bounded queues so a slow stage throttles the ones
+// before it instead of buffering the whole corpus.
+class LyricIngestPipeline
+{
+public:
+    enum Stage : size_t
+    {
+        Read = 0,
+        Decode = 1,
+        Parse = 2,
+        Index = 3
+    };
+
+    static constexpr size_t s_stage_count{4};
+
+    // called on the index threads with every file that made it through, an
+    // exception counts the file as an index error
+    using Sink = std::function<void(LyricIngestItem&&)>;
+
+    LyricIngestPipeline(const LyricIngestConfig& config, Sink sink);
+
+    LyricIngestPipeline(const LyricIngestPipeline&) = delete;
+
+    LyricIngestPipeline(LyricIngestPipeline&&) = delete;
+
+    LyricIngestPipeline& operator=(const LyricIngestPipeline&) = delete;
+
+    LyricIngestPipeline& operator=(LyricIngestPipeline&&) = delete;
+
+    ~LyricIngestPipeline();
+
+    // blocks until every path went through all stages or failed
+    LyricIngestStats run(const std::vector<std::string>& paths);
+
+    static const char* stage_name(Stage stage);
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64_t> m_items{0};
+
+        std::atomic<uint64_t> m_errors{0};
+
+        std::atomic<uint64_t> m_busy_ns{0};
+
+        std::atomic<uint64_t> m_depth_sum{0};
+
+        std::atomic<uint64_t> m_depth_samples{0};
+
+        std::atomic<size_t> m_max_depth{0};
+    };
+
+    using Queue = BoundedQueue<LyricIngestItem>;
+
+    // false or an exception drops the item and counts an error
+    bool process(Stage stage, LyricIngestItem& item) const;
+
+    void worker(Stage stage
+                , Queue& in
+                , Queue* out
+                , std::atomic<size_t>& live);
+
+    void record_depth(Stage stage, size_t depth);
+
+    LyricIngestConfig m_config;
+
+    Sink m_sink;
+
+    std::array<Counters, s_stage_count> m_counters;
+};
+}
@@ -0,0 +1,147 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace AudioToolKits
+{
+struct LyricInternStats
+{
+    uint64_t m_lookups{0};
+
+    // lookups answered by a string already in the table
+    uint64_t m_hits{0};
+
+    size_t m_strings{0};
+
+    // bytes of every string passed to intern()
+    uint64_t m_requested_bytes{0};
+
+    // bytes actually stored, each distinct string once
+    uint64_t m_stored_bytes{0};
+
+    [[nodiscard]] double dedup_ratio() const
+    {
+        return m_stored_bytes == 0
+                   ? 1.0
+                   : static_cast<double>(m_requested_bytes) / static_cast<double>(m_stored_bytes);
+    }
+};
+
+// Thread-safe sharded table storing each distinct string once. Returned views
+// stay valid for the lifetime of the table, nothing is ever removed.
+class LyricInternTable
+{
+public:
+    explicit LyricInternTable(size_t shard_count = 16);
+
+    LyricInternTable(const LyricInternTable&) = delete;
+
+    LyricInternTable(LyricInternTable&&) = delete;
+
+    LyricInternTable& operator=(const LyricInternTable&) = delete;
+
+    LyricInternTable& operator=(LyricInternTable&&) = delete;
+
+    ~LyricInternTable();
+
+    [[nodiscard]] std::string_view intern(std::string_view str);
+
+    [[nodiscard]] LyricInternStats stats() const;
+
+    // string bytes, chunk slack and hash set nodes
+    [[nodiscard]] size_t memory_usage() const;
+
+private:
+    static constexpr size_t s_chunk_size{64 * 1024};
+
+    struct Shard
+    {
+        mutable std::mutex m_mutex;
+
+        std::unordered_set<std::string_view> m_strings;
+
+        std::vector<std::unique_ptr<char[]>> m_chunks;
+
+        size_t m_chunk_bytes{0};
+
+        // free bytes at the end of the last chunk
+        size_t m_chunk_left{0};
+
+        uint64_t m_lookups{0};
+
+        uint64_t m_hits{0};
+
+        uint64_t m_requested_bytes{0};
+
+        uint64_t m_stored_bytes{0};
+    };
+
+    static char* allocate_locked(Shard& shard, size_t size);
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+// A line whose text points into a LyricInternTable.
+struct LyricInternedLine
+{
+    std::optional<int64_t> m_start_ms;
+
+    // key of a tag line ("ar" of "[ar: Carpenters]"), empty for text lines
+    std::string_view m_key;
+
+    std::string_view m_text;
+
+    [[nodiscard]] bool isTag() const
+    {
+        return !m_start_ms.has_value();
+    }
+
+    [[nodiscard]] bool isText() const
+    {
+        return m_start_ms.has_value();
+    }
+};
+
+// Parse result holding its line text and tag keys in an intern table. Documents
+// built on one shared table store every credit and chorus line once corpus-wide;
+// without a table a private one still shares repeated lines of the document.
+class LyricInternedDocument
+{
+public:
+    explicit LyricInternedDocument(const LyricParser& parser
+                                   , std::shared_ptr<LyricInternTable> table = nullptr);
+
+    [[nodiscard]] const std::vector<LyricInternedLine>& lines() const
+    {
+        return m_lines;
+    }
+
+    // value of the first tag with key, trimmed
+    [[nodiscard]] std::optional<std::string_view> tag(std::string_view key) const;
+
+    // the document as get_lrc() returned it
+    [[nodiscard]] std::vector<LyricLine> get_lrc() const;
+
+    [[nodiscard]] const std::shared_ptr<LyricInternTable>& table() const
+    {
+        return m_table;
+    }
+
+    // bytes owned by this document, the shared strings are charged to the table
+    [[nodiscard]] size_t memory_usage() const;
+
+private:
+    std::shared_ptr<LyricInternTable> m_table;
+
+    std::vector<LyricInternedLine> m_lines;
+};
+}
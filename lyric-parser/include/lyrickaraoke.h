@@ -0,0 +1,55 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyrictimeline.h>
+#include <cstdint>
+
+namespace AudioToolKits
+{
+struct LyricKaraokeState
+{
+    // LyricTimeline::npos when nothing is active
+    size_t m_line{LyricTimeline::npos};
+
+    size_t m_word{LyricTimeline::npos};
+
+    // active word inside the flattened line text, in bytes and in code points
+    uint32_t m_byte_offset{0};
+
+    uint32_t m_byte_length{0};
+
+    uint32_t m_codepoint_offset{0};
+
+    uint32_t m_codepoint_length{0};
+
+    // 0..1 fill of the active word and of the whole line
+    float m_word_progress{0.0f};
+
+    float m_line_progress{0.0f};
+};
+
+// Per-stream karaoke position over a shared LyricTimeline.
+// Monotonic updates walk forward from the previous position, so a frame costs
+// O(1) amortized, backward or long forward jumps fall back to binary search.
+class LyricKaraokeCursor
+{
+public:
+    explicit LyricKaraokeCursor(const LyricTimeline& timeline);
+
+    LyricKaraokeState update(int64_t time_ms);
+
+    void reset();
+
+private:
+    static constexpr size_t s_max_linear_steps{4};
+
+    const LyricTimeline* m_timeline;
+
+    int64_t m_last_ms{INT64_MIN};
+
+    size_t m_line{LyricTimeline::npos};
+
+    size_t m_word{LyricTimeline::npos};
+};
+}
@@ -0,0 +1,112 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace AudioToolKits
+{
+struct LyricLoadedFile
+{
+    std::string m_path;
+
+    // whole file, empty if m_ok is false
+    std::string m_bytes;
+
+    bool m_ok{false};
+};
+
+struct LyricLoaderStats
+{
+    uint64_t m_files{0};
+
+    uint64_t m_failed{0};
+
+    uint64_t m_bytes{0};
+
+    // system calls issued by the loader, io_uring_enter counts once per batch
+    uint64_t m_syscalls{0};
+
+    double m_seconds{0.0};
+
+    [[nodiscard]] double files_per_second() const
+    {
+        return m_seconds > 0.0 ? static_cast<double>(m_files + m_failed) / m_seconds : 0.0;
+    }
+
+    [[nodiscard]] double syscalls_per_file() const
+    {
+        return m_files + m_failed == 0
+                   ? 0.0
+                   : static_cast<double>(m_syscalls) / static_cast<double>(m_files + m_failed);
+    }
+};
+
+// Reads many whole files for batch parsing. On Linux the IoUring backend keeps
+// queue_depth files in flight and submits their openat/statx/read/close in
+// batches, one io_uring_enter per round trip instead of four or more system
+// calls per file. ThreadPool reads with plain blocking calls on worker threads
+// and is used wherever io_uring is missing or refused by the kernel.
+class LyricBatchLoader
+{
+public:
+    enum class Backend
+    {
+        Auto, IoUring, ThreadPool
+    };
+
+    // receives every file in completion order; the IoUring backend calls it on
+    // the loading thread, ThreadPool concurrently from its workers. If the ring
+    // fails mid-batch, its files in flight arrive failed and the files not yet
+    // started are read by ThreadPool, so every path arrives exactly once.
+    using Sink = std::function<void(LyricLoadedFile&&)>;
+
+    explicit LyricBatchLoader(Backend backend = Backend::Auto
+                              , size_t queue_depth = 64
+                              , size_t thread_count = 4);
+
+    LyricBatchLoader(const LyricBatchLoader&) = delete;
+
+    LyricBatchLoader(LyricBatchLoader&&) = delete;
+
+    LyricBatchLoader& operator=(const LyricBatchLoader&) = delete;
+
+    LyricBatchLoader& operator=(LyricBatchLoader&&) = delete;
+
+    ~LyricBatchLoader();
+
+    // backend actually used, never Auto
+    [[nodiscard]] Backend backend() const
+    {
+        return m_backend;
+    }
+
+    LyricLoaderStats load(const std::vector<std::string>& paths, const Sink& sink) const;
+
+    [[nodiscard]] static bool io_uring_available();
+
+    // for tests: io_uring_enter calls after the first after_calls fail with
+    // error_number, count times or for good when count is 0
+    void inject_submit_error(int error_number, size_t after_calls, size_t count = 0);
+
+private:
+    LyricLoaderStats load_io_uring(const std::vector<std::string>& paths, const Sink& sink) const;
+
+    LyricLoaderStats load_thread_pool(const std::vector<std::string>& paths, const Sink& sink) const;
+
+    Backend m_backend;
+
+    size_t m_queue_depth;
+
+    size_t m_thread_count;
+
+    int m_fault_errno{0};
+
+    size_t m_fault_after{0};
+
+    size_t m_fault_count{0};
+};
+}
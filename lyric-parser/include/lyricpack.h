@@ -0,0 +1,174 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricbinary.h>
+#include <mappedfile.h>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AudioToolKits
+{
+// Many compiled lyrics in one file, version 1, little-endian:
+//   header     64 bytes, see LyricPack::HeaderField
+//   blobs      compiled lyrics (LyricCompiler layout), 8-byte aligned
+//   directory  bucket_count x {u64 key hash, u64 blob offset, u32 blob size,
+//                              u32 key offset, u32 key length, u32 used}
+//   keys       key bytes referenced by the directory
+// Appends write new blobs and a new directory after the old one and patch the
+// header last, the replaced directory and superseded blobs count as dead bytes.
+struct LyricPack
+{
+    static constexpr char s_magic[4]{'L', 'R', 'C', 'P'};
+
+    static constexpr uint16_t s_version{1};
+
+    static constexpr size_t s_header_size{64};
+
+    static constexpr size_t s_bucket_size{32};
+
+    enum HeaderField : size_t
+    {
+        Magic = 0,
+        Version = 4,
+        FlagBits = 6,
+        HeaderSize = 8,
+        EntryCount = 12,
+        BucketCount = 16,
+        KeyPoolSize = 20,
+        DirectoryOffset = 24,
+        DeadBytes = 32,
+        TotalSize = 40
+    };
+
+    enum BucketField : size_t
+    {
+        KeyHash = 0,
+        BlobOffset = 8,
+        BlobSize = 16,
+        KeyOffset = 20,
+        KeyLength = 24,
+        Used = 28
+    };
+
+    static std::string path_key(std::string_view file_path);
+
+    static std::string song_id_key(uint64_t song_id);
+
+    static std::string artist_title_key(std::string_view artist
+                                        , std::string_view title);
+};
+
+class LyricPackBuilder
+{
+public:
+    // an existing pack at pack_path is opened for appending, any other existing
+    // file leaves the builder invalid and is never written
+    explicit LyricPackBuilder(std::string_view pack_path);
+
+    LyricPackBuilder(const LyricPackBuilder&) = delete;
+
+    LyricPackBuilder(LyricPackBuilder&&) = delete;
+
+    LyricPackBuilder& operator=(const LyricPackBuilder&) = delete;
+
+    LyricPackBuilder& operator=(LyricPackBuilder&&) = delete;
+
+    ~LyricPackBuilder();
+
+    // replaces any entry with the same key on commit()
+    void add(std::string_view key, const LyricParser& parser);
+
+    // parses the file with LyricParser and stores it under LyricPack::path_key()
+    void add_file(std::string_view lrc_path);
+
+    bool remove(std::string_view key);
+
+    bool commit();
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return m_is_valid;
+    }
+
+    [[nodiscard]] size_t entry_count() const
+    {
+        return m_entries.size();
+    }
+
+    // rewrites the pack with only live entries
+    static bool compact(std::string_view pack_path);
+
+private:
+    struct Entry
+    {
+        uint64_t m_offset{0};
+
+        uint32_t m_size{0};
+
+        // compiled bytes not yet written to the pack
+        std::string m_pending;
+    };
+
+    bool load_existing();
+
+    static std::string build_directory(const std::map<std::string, Entry>& entries
+                                       , uint32_t& bucket_count
+                                       , uint32_t& key_pool_size);
+
+    std::string m_pack_path;
+
+    std::map<std::string, Entry> m_entries;
+
+    bool m_is_valid{true};
+
+    uint64_t m_file_size{0};
+
+    uint64_t m_dead_bytes{0};
+
+    uint64_t m_directory_bytes{0};
+};
+
+// Read-only access to a mapped pack, safe to share across threads.
+class LyricPackReader
+{
+public:
+    explicit LyricPackReader(std::string_view pack_path);
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return m_directory != nullptr;
+    }
+
+    [[nodiscard]] std::optional<LyricBinaryView> find(std::string_view key) const;
+
+    [[nodiscard]] size_t entry_count() const
+    {
+        return m_entry_count;
+    }
+
+    [[nodiscard]] uint64_t dead_bytes() const
+    {
+        return m_dead_bytes;
+    }
+
+private:
+    MappedFile m_file;
+
+    const char* m_directory{nullptr};
+
+    const char* m_keys{nullptr};
+
+    uint32_t m_entry_count{0};
+
+    uint32_t m_bucket_count{0};
+
+    uint32_t m_key_pool_size{0};
+
+    uint64_t m_dead_bytes{0};
+};
+}
@@ -0,0 +1,637 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace AudioToolKits
+{
+// Compile-time policies of LyricParseCore.
+namespace LyricPolicy
+{
+// the first text line decides between standard and enhanced
+struct AutoFormat
+{
+    static constexpr bool s_detect{true};
+
+    static constexpr bool s_enhanced{false};
+};
+
+// word stamps are left in the text
+struct StandardFormat
+{
+    static constexpr bool s_detect{false};
+
+    static constexpr bool s_enhanced{false};
+};
+
+struct EnhancedFormat
+{
+    static constexpr bool s_detect{false};
+
+    static constexpr bool s_enhanced{true};
+};
+
+struct CaptureTags
+{
+    static constexpr bool s_capture{true};
+};
+
+// tag lines are consumed but not reported
+struct SkipTags
+{
+    static constexpr bool s_capture{false};
+};
+
+// whitespace and a UTF-8 BOM around line text and words
+struct TrimText
+{
+    static constexpr bool s_trim{true};
+};
+
+struct KeepText
+{
+    static constexpr bool s_trim{false};
+};
+}
+
+// LRC line grammar shared by every LyricParseCore instantiation.
+struct LyricSyntax
+{
+    // how long the last line stays on screen without a [length:] tag
+    static constexpr int64_t s_last_line_ms{5000};
+
+    struct TextLine
+    {
+        int64_t m_start_ms{0};
+
+        // untrimmed
+        std::string_view m_text;
+    };
+
+    // isdigit / isspace of the "C" locale
+    static constexpr bool is_digit(const char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static constexpr bool is_space(const char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // UTF-8 BOM and surrounding whitespace removed, as TextFileHelper::trim_string
+    static constexpr std::string_view trim(std::string_view str)
+    {
+        if (str.size() >= 3 && str.substr(0, 3) == "\xEF\xBB\xBF")
+        {
+            str.remove_prefix(3);
+        }
+        while (!str.empty() && is_space(str.front()))
+        {
+            str.remove_prefix(1);
+        }
+        while (!str.empty() && is_space(str.back()))
+        {
+            str.remove_suffix(1);
+        }
+        return str;
+    }
+
+    // next non-blank trimmed line of rest, empty at the end; the lines of
+    // TextFileHelper::split_lines() without the copies
+    static constexpr std::string_view next_line(std::string_view& rest)
+    {
+        while (!rest.empty())
+        {
+            const auto newline = rest.find('\n');
+            const std::string_view line = trim(rest.substr(0, newline));
+            rest = newline == std::string_view::npos ? std::string_view{} : rest.substr(newline + 1);
+            if (!line.empty())
+            {
+                return line;
+            }
+        }
+        return {};
+    }
+
+    // "<mm:ss.xxx> word" of an enhanced line, the word runs to the next '<'
+    struct WordStamp
+    {
+        std::string_view m_stamp;
+
+        // untrimmed
+        std::string_view m_word;
+    };
+
+    // [tag], "." does not match a line break
+    static constexpr std::optional<std::string_view> match_tag(const std::string_view line)
+    {
+        if (line.size() < 2 || line.front() != '[' || line.back() != ']' ||
+            line.find_first_of("\r\n") != std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        return line.substr(1, line.size() - 2);
+    }
+
+    // [mm:ss.xxx] with up to 7 minute digits or [h:mm:ss.xxx], an optional
+    // second fraction is ignored, then the text up to the end of the line
+    static constexpr std::optional<TextLine> match_text(const std::string_view line)
+    {
+        size_t pos{0};
+        if (line.empty() || line[pos++] != '[')
+        {
+            return std::nullopt;
+        }
+        const auto start_ms = scan_time(line, pos, true);
+        if (!start_ms || pos == line.size() || line[pos++] != ']')
+        {
+            return std::nullopt;
+        }
+        const std::string_view text = line.substr(pos);
+        if (text.find_first_of("\r\n") != std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        return TextLine{*start_ms, text};
+    }
+
+    // the whole of time_str is mm:ss.xxx or h:mm:ss.xxx
+    static constexpr std::optional<int64_t> match_time(const std::string_view time_str)
+    {
+        size_t pos{0};
+        const auto time_ms = scan_time(time_str, pos, false);
+        if (!time_ms || pos != time_str.size())
+        {
+            return std::nullopt;
+        }
+        return time_ms;
+    }
+
+    // first "<stamp>" at or after pos with a non-empty stamp, pos moves past its word
+    static constexpr std::optional<WordStamp> next_word(const std::string_view text, size_t& pos)
+    {
+        for (auto open = text.find('<', pos); open != std::string_view::npos; open = text.find('<', open + 1))
+        {
+            const auto close = text.find('>', open + 1);
+            if (close == std::string_view::npos)
+            {
+                break;
+            }
+            if (close > open + 1)
+            {
+                const auto next = std::min(text.find('<', close + 1), text.size());
+                pos = next;
+                return WordStamp{text.substr(open + 1, close - open - 1)
+                                 , text.substr(close + 1, next - close - 1)};
+            }
+        }
+        pos = text.size();
+        return std::nullopt;
+    }
+
+    // an enhanced line has at least one word stamp
+    static constexpr bool has_word_stamp(const std::string_view text)
+    {
+        size_t pos{0};
+        return next_word(text, pos).has_value();
+    }
+
+    // TextFileHelper::is_English() in the "C" locale, letters and apostrophes
+    static constexpr bool is_english(const std::string_view word)
+    {
+        for (const char c : word)
+        {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '\''))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct FlatLine
+    {
+        size_t m_length{0};
+
+        // none if every word is empty
+        std::optional<int64_t> m_last_word_ms;
+    };
+
+    // text of an enhanced line as LyricParser stores it: trimmed words without
+    // their stamps, an English word followed by a space, no trailing space;
+    // written to out unless it is null
+    static constexpr FlatLine flatten_words(const std::string_view text, char* out)
+    {
+        FlatLine flat;
+        // spaces after English words are written once something follows, the
+        // last one is dropped, so out needs no byte past the line
+        size_t pending_spaces{0};
+        const auto put = [&flat, out](const char c)
+        {
+            if (out != nullptr)
+            {
+                out[flat.m_length] = c;
+            }
+            ++flat.m_length;
+        };
+        size_t pos{0};
+        while (const auto stamp = next_word(text, pos))
+        {
+            const std::string_view word = trim(stamp->m_word);
+            if (!word.empty())
+            {
+                flat.m_last_word_ms = match_time(stamp->m_stamp).value_or(0);
+                for (; pending_spaces > 0; --pending_spaces)
+                {
+                    put(' ');
+                }
+            }
+            for (const char c : word)
+            {
+                put(c);
+            }
+            if (is_english(word))
+            {
+                ++pending_spaces;
+            }
+        }
+        for (; pending_spaces > 1; --pending_spaces)
+        {
+            put(' ');
+        }
+        return flat;
+    }
+
+    // true for a tag with the key "length", in any case
+    static constexpr bool is_length_tag(const std::string_view tag)
+    {
+        const auto colon = tag.find(':');
+        if (colon == std::string_view::npos)
+        {
+            return false;
+        }
+        const std::string_view key = trim(tag.substr(0, colon));
+        constexpr std::string_view length{"length"};
+        if (key.size() != length.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < key.size(); ++i)
+        {
+            const char c = key[i] >= 'A' && key[i] <= 'Z' ? static_cast<char>(key[i] - 'A' + 'a') : key[i];
+            if (c != length[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // [hh:]mm:ss[.xx] after the colon of a length tag, fractions of 1 to 3 digits
+    static constexpr std::optional<int64_t> length_ms(const std::string_view tag)
+    {
+        const auto colon = tag.find(':');
+        if (colon == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        int64_t seconds{0};
+        int64_t fraction_ms{0};
+        int64_t field{0};
+        int fraction_digits{-1};
+        bool has_digit{false};
+        for (const char c : tag.substr(colon + 1))
+        {
+            if (is_digit(c))
+            {
+                has_digit = true;
+                if (fraction_digits < 0)
+                {
+                    field = field * 10 + (c - '0');
+                }
+                else if (fraction_digits < 3)
+                {
+                    fraction_ms = fraction_ms * 10 + (c - '0');
+                    ++fraction_digits;
+                }
+            }
+            else if (c == ':' && fraction_digits < 0)
+            {
+                seconds = (seconds + field) * 60;
+                field = 0;
+            }
+            else if (c == '.' && fraction_digits < 0)
+            {
+                fraction_digits = 0;
+            }
+            else if (!is_space(c))
+            {
+                has_digit = false;
+                break;
+            }
+        }
+        if (!has_digit)
+        {
+            return std::nullopt;
+        }
+        for (; fraction_digits > 0 && fraction_digits < 3; ++fraction_digits)
+        {
+            fraction_ms *= 10;
+        }
+        return (seconds + field) * 1000 + fraction_ms;
+    }
+
+    // mm:ss.xxx or h:mm:ss.xxx, 0 if time_str is neither
+    static int64_t time_to_ms(std::string_view time_str);
+
+    static int64_t time_to_ms(std::string_view min
+                              , std::string_view sec
+                              , std::string_view ms);
+
+    static int64_t time_to_ms(std::string_view hour
+                              , std::string_view min
+                              , std::string_view sec
+                              , std::string_view ms);
+
+private:
+    // mm:ss.xxx or h:mm:ss.xxx from pos on, a 2 digit fraction is hundredths as in
+    // length_ms()
+    static constexpr std::optional<int64_t> scan_time(const std::string_view str
+                                                      , size_t& pos
+                                                      , const bool second_fraction)
+    {
+        int64_t fields[3]{};
+        size_t field_count{0};
+        // 1-7 digit minutes (or hours), then 1-2 digit fields
+        for (; field_count < 3; ++field_count)
+        {
+            const size_t max_digits = field_count == 0 ? 7 : 2;
+            const size_t first = pos;
+            while (pos < str.size() && pos - first < max_digits && is_digit(str[pos]))
+            {
+                fields[field_count] = fields[field_count] * 10 + (str[pos++] - '0');
+            }
+            if (pos == first || pos == str.size())
+            {
+                return std::nullopt;
+            }
+            if (str[pos] != ':' || field_count == 2)
+            {
+                break;
+            }
+            ++pos;
+        }
+        if (field_count == 0 || str[pos++] != '.')
+        {
+            return std::nullopt;
+        }
+        int64_t fraction{0};
+        const int group_count = second_fraction ? 2 : 1;
+        for (int group = 0; group < group_count; ++group)
+        {
+            const size_t first = pos;
+            int64_t value{0};
+            while (pos < str.size() && pos - first < 3 && is_digit(str[pos]))
+            {
+                value = value * 10 + (str[pos++] - '0');
+            }
+            if (pos - first < 2)
+            {
+                return std::nullopt;
+            }
+            if (group == 0)
+            {
+                fraction = pos - first == 2 ? value * 10 : value;
+            }
+            // a '.' is only taken when another group may follow, a trailing
+            // one is left for the caller to reject
+            if (group + 1 == group_count || pos == str.size() || str[pos] != '.')
+            {
+                break;
+            }
+            ++pos;
+        }
+        const int64_t seconds = field_count == 2
+                                    ? (fields[0] * 60 + fields[1]) * 60 + fields[2]
+                                    : fields[0] * 60 + fields[1];
+        return seconds * 1000 + fraction;
+    }
+};
+
+// Lines of an in-memory file as LyricSyntax::next_line() yields them, a
+// forward range of views into the buffer.
+class LyricBufferLines
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        constexpr iterator() = default;
+
+        constexpr explicit iterator(const std::string_view bytes)
+            : m_rest{bytes},
+              m_line{LyricSyntax::next_line(m_rest)}
+        {
+        }
+
+        constexpr reference operator*() const
+        {
+            return m_line;
+        }
+
+        constexpr pointer operator->() const
+        {
+            return &m_line;
+        }
+
+        constexpr iterator& operator++()
+        {
+            m_line = LyricSyntax::next_line(m_rest);
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            iterator previous{*this};
+            ++*this;
+            return previous;
+        }
+
+        // lines are never empty, the end iterator holds a null view
+        constexpr bool operator==(const iterator& other) const
+        {
+            return m_line.data() == other.m_line.data();
+        }
+
+        constexpr bool operator!=(const iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        std::string_view m_rest;
+
+        std::string_view m_line;
+    };
+
+    constexpr explicit LyricBufferLines(const std::string_view utf8_bytes)
+        : m_bytes{utf8_bytes}
+    {
+    }
+
+    [[nodiscard]] constexpr iterator begin() const
+    {
+        return iterator{m_bytes};
+    }
+
+    [[nodiscard]] constexpr iterator end() const
+    {
+        return {};
+    }
+
+private:
+    std::string_view m_bytes;
+};
+
+// Tag block and text lines of an LRC file, specialized at compile time by the
+// LyricPolicy types so an instantiation has no branch it cannot take. Results
+// go to a Sink with
+//   void on_tag(std::string_view key);
+//   void on_line_begin(int64_t start_ms);
+//   void on_word(int64_t start_ms, uint32_t offset, std::string_view text);
+//   void on_line_end(int64_t start_ms, std::string_view text);
+// where word offsets index the text of the following on_line_end, e.g. a
+// LyricVisitor. Views are only valid during the call. Lines are anything
+// convertible to string_view.
+template <typename Format, typename Tags, typename Trim>
+class LyricParseCore
+{
+public:
+    // a detected format carries over to the following parse_text calls
+    explicit LyricParseCore(const std::optional<bool> enhanced = std::nullopt)
+        : m_enhanced{Format::s_detect ? enhanced : std::optional<bool>{Format::s_enhanced}}
+    {
+    }
+
+    // none until an AutoFormat parse has seen a text line
+    [[nodiscard]] std::optional<bool> enhanced() const
+    {
+        return m_enhanced;
+    }
+
+    // each returns where it stopped matching
+    template <typename Iterator, typename Sink>
+    Iterator parse_tags(Iterator o_it, const Iterator end, Sink& sink)
+    {
+        for (; o_it != end; ++o_it)
+        {
+            const auto key = LyricSyntax::match_tag(std::string_view{*o_it});
+            if (!key)
+            {
+                break;
+            }
+            if constexpr (Tags::s_capture)
+            {
+                sink.on_tag(*key);
+            }
+        }
+        return o_it;
+    }
+
+    template <typename Iterator, typename Sink>
+    Iterator parse_text(Iterator o_it, const Iterator end, Sink& sink)
+    {
+        for (; o_it != end; ++o_it)
+        {
+            const auto line = LyricSyntax::match_text(std::string_view{*o_it});
+            if (!line)
+            {
+                break;
+            }
+            const int64_t start_ms = line->m_start_ms;
+            const std::string_view text = trim(line->m_text);
+            sink.on_line_begin(start_ms);
+            if constexpr (Format::s_detect)
+            {
+                if (!m_enhanced)
+                {
+                    m_enhanced = LyricSyntax::has_word_stamp(text);
+                }
+                if (*m_enhanced)
+                {
+                    parse_words(start_ms, text, sink);
+                }
+                else
+                {
+                    sink.on_line_end(start_ms, text);
+                }
+            }
+            else if constexpr (Format::s_enhanced)
+            {
+                parse_words(start_ms, text, sink);
+            }
+            else
+            {
+                sink.on_line_end(start_ms, text);
+            }
+        }
+        return o_it;
+    }
+
+private:
+    static std::string_view trim(const std::string_view str)
+    {
+        if constexpr (Trim::s_trim)
+        {
+            return LyricSyntax::trim(str);
+        }
+        return str;
+    }
+
+    // flattens "<t> word <t> word" into m_text, English words are space separated
+    template <typename Sink>
+    void parse_words(const int64_t start_ms, const std::string_view text, Sink& sink)
+    {
+        m_text.clear();
+        size_t pos{0};
+        while (const auto stamp = LyricSyntax::next_word(text, pos))
+        {
+            const std::string_view word = trim(stamp->m_word);
+            if (!word.empty())
+            {
+                sink.on_word(LyricSyntax::match_time(stamp->m_stamp).value_or(0)
+                          , static_cast<uint32_t>(m_text.size())
+                          , word);
+            }
+            m_text.append(word);
+            if (LyricSyntax::is_english(word))
+            {
+                m_text += ' ';
+            }
+        }
+        if (!m_text.empty() && LyricSyntax::is_space(m_text.back()))
+        {
+            m_text.pop_back();
+        }
+        sink.on_line_end(start_ms, m_text);
+    }
+
+    std::optional<bool> m_enhanced;
+
+    // reused across lines
+    std::string m_text;
+};
+}
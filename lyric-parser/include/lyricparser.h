@@ -2,10 +2,13 @@
 // Created by 31305 on 25-6-18.
 //
 #pragma once
+#include <lyricparsecore.h>
+#include <lyricvisitor.h>
 #include <string>
 #include <vector>
+#include <memory>
+#include <memory_resource>
 #include <optional>
-#include <regex>
 #include <cstdint>
 
 namespace AudioToolKits
@@ -19,7 +22,17 @@ struct LyricLine
     LyricLine() = default;
 
     explicit LyricLine(std::string&& text)
-        :m_text(std::move(text))
+        : m_text(std::move(text))
+    {
+    }
+
+    explicit LyricLine(const std::string_view text)
+        : m_text(text)
+    {
+    }
+
+    explicit LyricLine(const char* text)
+        : m_text(text)
     {
     }
 
@@ -30,6 +43,20 @@ struct LyricLine
     {
     }
 
+    LyricLine(const int64_t time_ms
+              , const std::string_view text)
+        : m_start_ms(time_ms),
+          m_text(text)
+    {
+    }
+
+    LyricLine(const int64_t time_ms
+              , const char* text)
+        : m_start_ms(time_ms),
+          m_text(text)
+    {
+    }
+
     LyricLine(const LyricLine& other) = default;
 
     LyricLine(LyricLine&& other) = default;
@@ -63,15 +90,198 @@ struct LyricLine
     }
 };
 
+// A LyricLine as LyricParser stores it. Allocator-aware, a std::pmr container
+// hands its resource down to m_text; get_lrc() and get_text() copy out
+// LyricLines on the default heap.
+struct LyricArenaLine
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    std::optional<int64_t> m_start_ms;
+
+    std::pmr::string m_text;
+
+    LyricArenaLine() = default;
+
+    explicit LyricArenaLine(const std::string_view text
+                            , const allocator_type& alloc = {})
+        : m_text(text, alloc)
+    {
+    }
+
+    LyricArenaLine(const int64_t time_ms
+                   , const std::string_view text
+                   , const allocator_type& alloc = {})
+        : m_start_ms(time_ms),
+          m_text(text, alloc)
+    {
+    }
+
+    LyricArenaLine(const LyricArenaLine& other) = default;
+
+    LyricArenaLine(LyricArenaLine&& other) = default;
+
+    LyricArenaLine(const LyricArenaLine& other
+                   , const allocator_type& alloc)
+        : m_start_ms(other.m_start_ms),
+          m_text(other.m_text, alloc)
+    {
+    }
+
+    LyricArenaLine(LyricArenaLine&& other
+                   , const allocator_type& alloc)
+        : m_start_ms(other.m_start_ms),
+          m_text(std::move(other.m_text), alloc)
+    {
+    }
+
+    LyricArenaLine& operator=(const LyricArenaLine& other) = default;
+
+    LyricArenaLine& operator=(LyricArenaLine&& other) noexcept = default;
+
+    [[nodiscard]] bool isTag() const
+    {
+        return !m_start_ms.has_value();
+    }
+
+    [[nodiscard]] bool isText() const
+    {
+        return m_start_ms.has_value();
+    }
+
+    [[nodiscard]] int64_t start_ms() const
+    {
+        return m_start_ms.value();
+    }
+
+    [[nodiscard]] LyricLine to_line() const
+    {
+        LyricLine line{std::string_view{m_text}};
+        line.m_start_ms = m_start_ms;
+        return line;
+    }
+};
+
+// Word timing of an enhanced LRC line.
+struct LyricWord
+{
+    int64_t m_start_ms{0};
+
+    // index into get_text()
+    uint32_t m_line{0};
+
+    // byte range of the word inside the flattened line text
+    uint32_t m_offset{0};
+
+    uint32_t m_length{0};
+
+    bool operator==(const LyricWord& other) const
+    {
+        return m_start_ms == other.m_start_ms && m_line == other.m_line &&
+               m_offset == other.m_offset && m_length == other.m_length;
+    }
+
+    bool operator!=(const LyricWord& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// The LyricVisitor behind LyricParser: materializes tags and lines into a
+// vector of LyricLine (or LyricArenaLine, as the parser stores them), and the
+// words of enhanced lines numbered from line_index on.
+template <typename Lines>
+class LyricBasicLineCollector final : public LyricVisitor
+{
+public:
+    LyricBasicLineCollector(Lines& lines
+                            , std::vector<LyricWord>& words
+                            , const uint32_t line_index = 0)
+        : m_lines{lines},
+          m_words{words},
+          m_line_index{line_index}
+    {
+    }
+
+    void on_tag(const std::string_view key) override
+    {
+        m_lines.emplace_back(key);
+    }
+
+    void on_word(const int64_t start_ms, const uint32_t offset, const std::string_view text) override
+    {
+        m_words.push_back(LyricWord{start_ms
+                                    , m_line_index
+                                    , offset
+                                    , static_cast<uint32_t>(text.size())});
+    }
+
+    void on_line_end(const int64_t start_ms, const std::string_view text) override
+    {
+        m_lines.emplace_back(start_ms, text);
+        ++m_line_index;
+    }
+
+private:
+    Lines& m_lines;
+
+    std::vector<LyricWord>& m_words;
+
+    uint32_t m_line_index;
+};
+
+using LyricLineCollector = LyricBasicLineCollector<std::vector<LyricLine>>;
+
 class LyricParser
 {
 public:
-    explicit LyricParser(std::string_view file_path);
+    // the grammar behind parse_lrc(), other instantiations of LyricParseCore
+    // drop the features a consumer does not need
+    using ParseCore = LyricParseCore<LyricPolicy::AutoFormat
+                                     , LyricPolicy::CaptureTags
+                                     , LyricPolicy::TrimText>;
+
+    // how long the last line stays on screen without a [length:] tag
+    static constexpr int64_t s_last_line_ms{LyricSyntax::s_last_line_ms};
+
+    // below this many bytes of lines the parse stays on the calling thread
+    static constexpr size_t s_parallel_threshold{1024 * 1024};
+
+    // results and file buffers are allocated from resource, which must outlive the
+    // parser; a std::pmr::monotonic_buffer_resource per file or per batch frees
+    // every line at once
+    explicit LyricParser(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    explicit LyricParser(std::string_view file_path
+                         , std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     ~LyricParser();
 
+    // inputs of parallel_threshold() bytes or more are parsed in chunks of
+    // whole lines on several threads and merged in order
     void parse_lrc(const std::vector<std::string>& file_content);
 
+    // whole file in memory, split at newlines
+    void parse_buffer(std::string_view utf8_bytes);
+
+    // stream the parse to visitor without building LyricLines, unsorted, on the
+    // calling thread and with diagnostics; parse_lrc() builds its lines through
+    // a LyricBasicLineCollector the same way, then sorts them and computes the
+    // end times
+    static void visit_lrc(const std::vector<std::string>& file_content
+                          , LyricVisitor& visitor);
+
+    static void visit_buffer(std::string_view utf8_bytes, LyricVisitor& visitor);
+
+    // GBK files are converted first, false if nothing could be read
+    static bool visit_file(std::string_view file_path, LyricVisitor& visitor);
+
+    // max_threads 0 uses every hardware thread, SIZE_MAX bytes disables chunking
+    void set_parallel_parse(size_t threshold_bytes, size_t max_threads = 0);
+
+    [[nodiscard]] size_t parallel_threshold() const;
+
+    // mutates the results in place, share parsed results through LyricDocument instead
     void reload_file(std::string_view file_path);
 
 
@@ -81,16 +291,61 @@ public:
                                        , std::string_view sec
                                        , std::string_view ms);
 
+    static int64_t time_to_ms(std::string_view hour
+                              , std::string_view min
+                              , std::string_view sec
+                              , std::string_view ms);
+
     [[nodiscard]] std::vector<LyricLine> get_lrc() const;
 
     [[nodiscard]] std::vector<std::string> get_tags() const;
 
     [[nodiscard]] std::vector<LyricLine> get_text() const;
 
+    // tags and text lines, one per input line consumed by the parse
+    [[nodiscard]] size_t line_count() const
+    {
+        return m_lyric_vector.size();
+    }
+
+    // the leading tag lines of get_lrc(), without copying them
+    [[nodiscard]] size_t tag_count() const;
+
+    // empty unless the lyric is enhanced
+    [[nodiscard]] const std::vector<LyricWord>& get_words() const;
+
+    // end time of every get_text() line: the next line's start, [length:] or
+    // s_last_line_ms for the last one, capped by the max line duration
+    [[nodiscard]] const std::vector<int64_t>& get_end_ms() const;
+
+    // caps instrumental gaps, recomputes the end times of the current result
+    void set_max_line_duration_ms(std::optional<int64_t> max_duration_ms);
+
+    [[nodiscard]] std::optional<int64_t> max_line_duration_ms() const;
+
+    // [length: mm:ss.xx] from the tags, if present
+    [[nodiscard]] std::optional<int64_t> length_ms() const;
+
     [[nodiscard]] bool is_enhanced() const;
 
+    [[nodiscard]] std::pmr::memory_resource* resource() const
+    {
+        return m_resource;
+    }
+
+    // heap and inline bytes owned by this parser, SSO strings are not counted twice
+    [[nodiscard]] size_t memory_usage() const;
+
     void clear_result();
 
+    // appends the result of parsing the lines that follow in the same file,
+    // e.g. one chunk of a large file; words are renumbered, order and end
+    // times recomputed. Both sides must have been parsed in the same format.
+    void append(const LyricParser& next);
+
+    // append() of several chunks in order with a single sort and end time pass
+    void append(const std::vector<const LyricParser*>& parts);
+
     void change_encoding_utf8();
 
     void print_lyric() const;
@@ -101,22 +356,44 @@ private:
         Uninitialized, True, False
     };
 
-    std::vector<LyricLine> m_lyric_vector;
+    // std::vector<std::string> or the std::pmr buffers of a TextFileHelper
+    template <typename Content>
+    void parse_content(const Content& file_content);
 
-    EnhancedState m_is_enhanced{EnhancedState::Uninitialized};
+    // each returns where it stopped matching
+    template <typename Iterator>
+    Iterator parse_tags(Iterator o_it, Iterator end);
 
-    inline static const std::regex s_regex_match_tag{R"(\[(.*)\])"};
+    template <typename Iterator>
+    Iterator parse_text(Iterator o_it, Iterator end);
 
-    inline static const std::regex s_regex_search_enhanced_text{
-        R"(<([^>]+)>(.*?)(?=<|$))"
-    };
+    template <typename Iterator>
+    void parse_text_parallel(Iterator o_it, Iterator end, size_t threads);
 
-    inline static const std::regex s_regex_match_text{
-        R"(\[(\d{1,2}):(\d{1,2})\.(\d{2,3})(?:\.(\d{2,3}))?\](.*))"
-    };
+    // append() without reordering
+    void append_lines(const LyricParser& next);
 
-    inline static const std::regex s_regex_match_time{
-        R"((\d{1,2}):(\d{1,2})\.(\d{2,3}))"
-    };
+    void sort_text_lines();
+
+    void compute_end_times();
+
+    std::pmr::memory_resource* m_resource;
+
+    std::pmr::vector<LyricArenaLine> m_lyric_vector;
+
+    std::vector<LyricWord> m_word_vector;
+
+    std::vector<int64_t> m_end_vector;
+
+    std::optional<int64_t> m_max_line_duration_ms;
+
+    EnhancedState m_is_enhanced{EnhancedState::Uninitialized};
+
+    size_t m_parallel_threshold{s_parallel_threshold};
+
+    size_t m_parallel_threads{0};
 };
+
+// Immutable, reference counted parse result shared between threads.
+using LyricDocument = std::shared_ptr<const LyricParser>;
 }
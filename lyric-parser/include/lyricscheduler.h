@@ -0,0 +1,158 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AudioToolKits
+{
+struct LyricPoolStats
+{
+    // tasks run by each worker
+    std::vector<uint64_t> m_executed;
+
+    // tasks taken from another worker's deque
+    uint64_t m_steals{0};
+
+    // tasks that threw, the worker logs the exception and carries on
+    uint64_t m_failed{0};
+};
+
+// Fixed set of workers, each owning a deque. A worker pushes and pops its own
+// tasks at the back (depth first, cache warm) and, once empty, steals the
+// oldest task at the front of a victim, so uneven task trees even out.
+class LyricWorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit LyricWorkStealingPool(size_t thread_count = std::thread::hardware_concurrency());
+
+    LyricWorkStealingPool(const LyricWorkStealingPool&) = delete;
+
+    LyricWorkStealingPool(LyricWorkStealingPool&&) = delete;
+
+    LyricWorkStealingPool& operator=(const LyricWorkStealingPool&) = delete;
+
+    LyricWorkStealingPool& operator=(LyricWorkStealingPool&&) = delete;
+
+    // waits for the queued tasks, then joins the workers
+    ~LyricWorkStealingPool();
+
+    // from a worker the task goes to that worker's deque, otherwise round robin;
+    // an exception a task throws is caught, logged and counted in stats()
+    void submit(Task task);
+
+    // blocks until every submitted task, including the ones they spawned, ran
+    void wait_idle();
+
+    [[nodiscard]] size_t thread_count() const
+    {
+        return m_workers.size();
+    }
+
+    [[nodiscard]] LyricPoolStats stats() const;
+
+private:
+    struct Worker
+    {
+        std::mutex m_mutex;
+
+        std::deque<Task> m_tasks;
+
+        std::atomic<uint64_t> m_executed{0};
+    };
+
+    bool pop_or_steal(size_t self, Task& task);
+
+    void run(size_t self);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::vector<std::thread> m_threads;
+
+    // submitted and not finished
+    std::atomic<size_t> m_pending{0};
+
+    // sitting in a deque, guarded by m_sleep_mutex for the sleepers
+    std::atomic<size_t> m_queued{0};
+
+    std::atomic<size_t> m_next_victim{0};
+
+    std::atomic<uint64_t> m_steals{0};
+
+    std::atomic<uint64_t> m_failed{0};
+
+    std::mutex m_sleep_mutex;
+
+    std::condition_variable m_work_available;
+
+    std::condition_variable m_idle;
+
+    bool m_stop{false};
+};
+
+struct LyricParsedFile
+{
+    std::string m_path;
+
+    LyricDocument m_document;
+
+    // sub-tasks the file was parsed in, 1 below LyricDirectoryParser::Options::m_split_bytes
+    size_t m_chunks{1};
+};
+
+// Walks directory trees in parallel on a LyricWorkStealingPool: every directory
+// is a task that spawns tasks for its subdirectories and files. Files above
+// m_split_bytes are parsed as m_split_lines-line chunks in separate tasks and
+// merged by whichever chunk finishes last.
+class LyricDirectoryParser
+{
+public:
+    struct Options
+    {
+        std::vector<std::string> m_extensions{".lrc", ".lyc"};
+
+        uintmax_t m_split_bytes{1024 * 1024};
+
+        size_t m_split_lines{8192};
+    };
+
+    // called concurrently from the workers
+    using Sink = std::function<void(LyricParsedFile&&)>;
+
+    LyricDirectoryParser(LyricWorkStealingPool& pool, Options options);
+
+    // schedules the walk and returns, pool.wait_idle() waits for it
+    void parse_tree(const std::filesystem::path& root, Sink sink);
+
+    // schedules one file, for callers that partition on their own
+    void parse_file(const std::filesystem::path& file, uintmax_t size, Sink sink);
+
+private:
+    void walk(const std::filesystem::path& directory, const std::shared_ptr<Sink>& sink);
+
+    void schedule_file(const std::filesystem::path& file
+                       , uintmax_t size
+                       , const std::shared_ptr<Sink>& sink);
+
+    void parse_split(const std::filesystem::path& file, const std::shared_ptr<Sink>& sink);
+
+    [[nodiscard]] bool wanted(const std::filesystem::path& file) const;
+
+    LyricWorkStealingPool& m_pool;
+
+    Options m_options;
+};
+}
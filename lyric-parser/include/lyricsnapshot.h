@@ -0,0 +1,51 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <atomic>
+#include <memory>
+#include <string_view>
+
+namespace AudioToolKits
+{
+// Holds the current LyricDocument for concurrent readers.
+// A reload parses into a new document and swaps the pointer, readers keep the
+// snapshot they loaded alive and never wait for the parse.
+class LyricSnapshot
+{
+public:
+    LyricSnapshot();
+
+    explicit LyricSnapshot(LyricDocument document);
+
+    LyricSnapshot(const LyricSnapshot&) = delete;
+
+    LyricSnapshot(LyricSnapshot&&) = delete;
+
+    LyricSnapshot& operator=(const LyricSnapshot&) = delete;
+
+    LyricSnapshot& operator=(LyricSnapshot&&) = delete;
+
+    ~LyricSnapshot();
+
+    // never null, an empty document is published before the first reload
+    [[nodiscard]] LyricDocument load() const;
+
+    void publish(LyricDocument document);
+
+    // parses file_path on the calling thread, then publishes the result
+    LyricDocument reload_file(std::string_view file_path);
+
+    [[nodiscard]] uint64_t version() const;
+
+    static LyricDocument parse_file(std::string_view file_path);
+
+private:
+    // accessed only through std::atomic_load / std::atomic_store; one layout
+    // whatever -std the including translation unit is built with
+    LyricDocument m_current;
+
+    std::atomic<uint64_t> m_version{0};
+};
+}
@@ -0,0 +1,254 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparsecore.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace AudioToolKits
+{
+// Compile-time line scan of an LRC literal, the same grammar as
+// TextFileHelper::split_lines() followed by LyricParser::parse_lrc().
+namespace LyricStatic
+{
+constexpr size_t count_tags(std::string_view lrc)
+{
+    size_t count{0};
+    while (LyricSyntax::match_tag(LyricSyntax::next_line(lrc)))
+    {
+        ++count;
+    }
+    return count;
+}
+
+// text lines after the tags, up to the first line that is neither
+constexpr size_t count_lines(std::string_view lrc)
+{
+    std::string_view line = LyricSyntax::next_line(lrc);
+    while (LyricSyntax::match_tag(line))
+    {
+        line = LyricSyntax::next_line(lrc);
+    }
+    size_t count{0};
+    for (; LyricSyntax::match_text(line); line = LyricSyntax::next_line(lrc))
+    {
+        ++count;
+    }
+    return count;
+}
+
+// flattened bytes of the text lines when the first one has word stamps, else 0
+constexpr size_t count_text_bytes(std::string_view lrc)
+{
+    std::string_view line = LyricSyntax::next_line(lrc);
+    while (LyricSyntax::match_tag(line))
+    {
+        line = LyricSyntax::next_line(lrc);
+    }
+    size_t bytes{0};
+    bool enhanced{false};
+    for (bool first = true; LyricSyntax::match_text(line); line = LyricSyntax::next_line(lrc), first = false)
+    {
+        const std::string_view text = LyricSyntax::trim(LyricSyntax::match_text(line)->m_text);
+        if (first)
+        {
+            enhanced = LyricSyntax::has_word_stamp(text);
+        }
+        if (!enhanced)
+        {
+            return 0;
+        }
+        bytes += LyricSyntax::flatten_words(text, nullptr).m_length;
+    }
+    return bytes;
+}
+}
+
+// Lyric parsed at compile time from a string literal it borrows from, for
+// built-in content: no startup parse and no heap. Queries follow
+// LyricTimeline. Text lines are sorted by time; enhanced lines are flattened
+// into TextBytes of inline storage, as LyricParser::get_text() returns them.
+//
+//   static constexpr std::string_view s_lrc{"[ti: Boot]\n[00:01.00] Hello"};
+//   static constexpr auto s_doc = LYRIC_STATIC_DOCUMENT(s_lrc);
+template <size_t TagCount, size_t LineCount, size_t TextBytes = 0>
+class LyricStaticDocument
+{
+public:
+    static constexpr size_t npos{static_cast<size_t>(-1)};
+
+    constexpr explicit LyricStaticDocument(std::string_view lrc)
+    {
+        std::string_view line = LyricSyntax::next_line(lrc);
+        for (size_t i = 0; i < TagCount; ++i, line = LyricSyntax::next_line(lrc))
+        {
+            m_tags[i] = *LyricSyntax::match_tag(line);
+        }
+        size_t text_bytes{0};
+        for (size_t i = 0; i < LineCount; ++i, line = LyricSyntax::next_line(lrc))
+        {
+            const auto text_line = *LyricSyntax::match_text(line);
+            m_line_start_ms[i] = text_line.m_start_ms;
+            m_line_text[i] = LyricSyntax::trim(text_line.m_text);
+            if (i == 0)
+            {
+                m_is_enhanced = LyricSyntax::has_word_stamp(m_line_text[i]);
+            }
+            if (m_is_enhanced)
+            {
+                // offsets into m_text, a view into the object would not survive a copy
+                const auto flat = LyricSyntax::flatten_words(m_line_text[i], m_text.data() + text_bytes);
+                m_flat_offset[i] = text_bytes;
+                m_flat_length[i] = flat.m_length;
+                m_last_word_ms[i] = flat.m_last_word_ms;
+                text_bytes += flat.m_length;
+            }
+        }
+
+        // stable insertion sort, as LyricParser orders its text lines
+        for (size_t i = 1; i < LineCount; ++i)
+        {
+            for (size_t j = i; j > 0 && m_line_start_ms[j] < m_line_start_ms[j - 1]; --j)
+            {
+                swap_lines(j, j - 1);
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr size_t tag_count() const
+    {
+        return TagCount;
+    }
+
+    [[nodiscard]] constexpr std::string_view tag(const size_t index) const
+    {
+        return m_tags[index];
+    }
+
+    [[nodiscard]] constexpr size_t line_count() const
+    {
+        return LineCount;
+    }
+
+    [[nodiscard]] constexpr int64_t line_start_ms(const size_t line) const
+    {
+        return m_line_start_ms[line];
+    }
+
+    // see LyricParser::get_end_ms(), without a max line duration
+    [[nodiscard]] constexpr int64_t line_end_ms(const size_t line) const
+    {
+        if (line + 1 < LineCount)
+        {
+            return m_line_start_ms[line + 1];
+        }
+        if (const auto length = length_ms(); length && *length > m_line_start_ms[line])
+        {
+            return *length;
+        }
+        // an enhanced last line outlives its last word
+        const int64_t last_start = m_last_word_ms[line] && *m_last_word_ms[line] > m_line_start_ms[line]
+                                       ? *m_last_word_ms[line]
+                                       : m_line_start_ms[line];
+        return last_start + LyricSyntax::s_last_line_ms;
+    }
+
+    [[nodiscard]] constexpr std::string_view line_text(const size_t line) const
+    {
+        if (m_is_enhanced)
+        {
+            return std::string_view{m_text.data() + m_flat_offset[line], m_flat_length[line]};
+        }
+        return m_line_text[line];
+    }
+
+    [[nodiscard]] constexpr const std::array<int64_t, LineCount>& line_starts() const
+    {
+        return m_line_start_ms;
+    }
+
+    // last line started at or before time_ms, npos before the first line
+    [[nodiscard]] constexpr size_t find_line(const int64_t time_ms) const
+    {
+        size_t first{0};
+        size_t count{LineCount};
+        while (count > 0)
+        {
+            const size_t half = count / 2;
+            if (m_line_start_ms[first + half] <= time_ms)
+            {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else
+            {
+                count = half;
+            }
+        }
+        return first == 0 ? npos : first - 1;
+    }
+
+    // [length: mm:ss.xx] from the tags, if present
+    [[nodiscard]] constexpr std::optional<int64_t> length_ms() const
+    {
+        for (const auto tag : m_tags)
+        {
+            if (LyricSyntax::is_length_tag(tag))
+            {
+                return LyricSyntax::length_ms(tag);
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] constexpr bool is_enhanced() const
+    {
+        return m_is_enhanced;
+    }
+
+private:
+    template <typename T>
+    static constexpr void swap_values(T& a, T& b)
+    {
+        T value = a;
+        a = b;
+        b = value;
+    }
+
+    constexpr void swap_lines(const size_t a, const size_t b)
+    {
+        swap_values(m_line_start_ms[a], m_line_start_ms[b]);
+        swap_values(m_line_text[a], m_line_text[b]);
+        swap_values(m_flat_offset[a], m_flat_offset[b]);
+        swap_values(m_flat_length[a], m_flat_length[b]);
+        swap_values(m_last_word_ms[a], m_last_word_ms[b]);
+    }
+
+    std::array<std::string_view, TagCount> m_tags{};
+
+    std::array<int64_t, LineCount> m_line_start_ms{};
+
+    // trimmed line as written, word stamps included
+    std::array<std::string_view, LineCount> m_line_text{};
+
+    // enhanced only, the flattened text in m_text
+    std::array<size_t, LineCount> m_flat_offset{};
+
+    std::array<size_t, LineCount> m_flat_length{};
+
+    std::array<std::optional<int64_t>, LineCount> m_last_word_ms{};
+
+    std::array<char, TextBytes> m_text{};
+
+    bool m_is_enhanced{false};
+};
+}
+
+// a constexpr std::string_view in, a LyricStaticDocument sized for it out
+#define LYRIC_STATIC_DOCUMENT(lrc) \
+    ::AudioToolKits::LyricStaticDocument<::AudioToolKits::LyricStatic::count_tags(lrc) \
+                                         , ::AudioToolKits::LyricStatic::count_lines(lrc) \
+                                         , ::AudioToolKits::LyricStatic::count_text_bytes(lrc)>{lrc}
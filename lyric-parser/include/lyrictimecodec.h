@@ -0,0 +1,76 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AudioToolKits
+{
+// Compressed timestamp stream, all integers little-endian:
+//   header       12 bytes, u32 count, u32 checkpoint interval, u32 checkpoint count
+//   checkpoints  checkpoint count x u32, payload offset of every block
+//   payload      blocks of interval values: the first one absolute, the others
+//                deltas to their predecessor, each a zig-zag LEB128 varint
+// Monotonic line and word times mostly take 2 bytes a value instead of 8.
+// Nothing in the library writes it yet: pack blobs and LRCB keep raw times so
+// LyricBinaryView can binary search them in the mapping without a decode.
+class LyricTimeCodec
+{
+public:
+    static constexpr uint32_t s_default_checkpoint_interval{64};
+
+    static constexpr size_t s_header_size{12};
+
+    static std::string encode(const int64_t* times
+                              , size_t count
+                              , uint32_t checkpoint_interval = s_default_checkpoint_interval);
+
+    static std::string encode(const std::vector<int64_t>& times
+                              , uint32_t checkpoint_interval = s_default_checkpoint_interval);
+};
+
+// Decoder over an encoded stream held in memory, the stream is not copied.
+class LyricTimeView
+{
+public:
+    LyricTimeView() = default;
+
+    LyricTimeView(const char* data, size_t size);
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_count;
+    }
+
+    // value at index, decodes at most one block from its checkpoint
+    [[nodiscard]] int64_t at(size_t index) const;
+
+    // appends values [first, first + count) to out, false on a malformed stream
+    bool decode(size_t first
+                , size_t count
+                , std::vector<int64_t>& out) const;
+
+    bool decode(std::vector<int64_t>& out) const;
+
+private:
+    const char* m_data{nullptr};
+
+    const char* m_checkpoints{nullptr};
+
+    const char* m_payload{nullptr};
+
+    size_t m_payload_size{0};
+
+    uint32_t m_count{0};
+
+    uint32_t m_interval{0};
+};
+}
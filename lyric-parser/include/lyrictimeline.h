@@ -0,0 +1,173 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyricparser.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AudioToolKits
+{
+// Half-open range [m_first, m_last) of line indices borrowed from a LyricTimeline.
+struct LyricLineRange
+{
+    size_t m_first{0};
+
+    size_t m_last{0};
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_last > m_first ? m_last - m_first : 0;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_last <= m_first;
+    }
+
+    [[nodiscard]] bool contains(const size_t line) const
+    {
+        return line >= m_first && line < m_last;
+    }
+
+    bool operator==(const LyricLineRange& other) const
+    {
+        return (empty() && other.empty()) ||
+               (m_first == other.m_first && m_last == other.m_last);
+    }
+
+    bool operator!=(const LyricLineRange& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// Immutable, time-ordered view of the text lines and word timings of a parse,
+// stored as parallel contiguous arrays for lookups on hot paths.
+class LyricTimeline
+{
+public:
+    static constexpr size_t npos{static_cast<size_t>(-1)};
+
+    LyricTimeline() = default;
+
+    explicit LyricTimeline(const LyricParser& parser);
+
+    [[nodiscard]] size_t line_count() const
+    {
+        return m_line_start_ms.size();
+    }
+
+    [[nodiscard]] int64_t line_start_ms(const size_t line) const
+    {
+        return m_line_start_ms[line];
+    }
+
+    // see LyricParser::get_end_ms()
+    [[nodiscard]] int64_t line_end_ms(const size_t line) const
+    {
+        return m_line_end_ms[line];
+    }
+
+    [[nodiscard]] std::string_view line_text(size_t line) const;
+
+    [[nodiscard]] const std::vector<int64_t>& line_starts() const
+    {
+        return m_line_start_ms;
+    }
+
+    [[nodiscard]] size_t word_count() const
+    {
+        return m_word_start_ms.size();
+    }
+
+    [[nodiscard]] int64_t word_start_ms(const size_t word) const
+    {
+        return m_word_start_ms[word];
+    }
+
+    // words of a line are [line_first_word(line), line_first_word(line + 1))
+    [[nodiscard]] size_t line_first_word(const size_t line) const
+    {
+        return m_line_first_word[line];
+    }
+
+    // start of the next word in the line, or the end of the line
+    [[nodiscard]] int64_t word_end_ms(const size_t word) const
+    {
+        return m_word_end_ms[word];
+    }
+
+    [[nodiscard]] uint32_t word_offset(const size_t word) const
+    {
+        return m_word_offset[word];
+    }
+
+    [[nodiscard]] uint32_t word_length(const size_t word) const
+    {
+        return m_word_length[word];
+    }
+
+    // UTF-8 code points before the word in its line
+    [[nodiscard]] uint32_t word_codepoint_offset(const size_t word) const
+    {
+        return m_word_codepoint_offset[word];
+    }
+
+    [[nodiscard]] uint32_t word_codepoint_length(const size_t word) const
+    {
+        return m_word_codepoint_length[word];
+    }
+
+    [[nodiscard]] std::string_view word_text(size_t word) const;
+
+    // last line started at or before time_ms, npos before the first line
+    [[nodiscard]] size_t find_line(int64_t time_ms) const;
+
+    // last word of line started at or before time_ms, npos if none
+    [[nodiscard]] size_t find_word(size_t line, int64_t time_ms) const;
+
+    // lines on screen at some point of [begin_ms, end_ms), widened by
+    // context_before / context_after lines and clamped to the timeline
+    [[nodiscard]] LyricLineRange line_range(int64_t begin_ms
+                                            , int64_t end_ms
+                                            , size_t context_before = 0
+                                            , size_t context_after = 0) const;
+
+    [[nodiscard]] bool is_enhanced() const
+    {
+        return m_is_enhanced;
+    }
+
+    [[nodiscard]] size_t memory_usage() const;
+
+private:
+    std::vector<int64_t> m_line_start_ms;
+
+    std::vector<int64_t> m_line_end_ms;
+
+    // line i is m_text_pool[m_text_offset[i], m_text_offset[i + 1])
+    std::vector<uint32_t> m_text_offset;
+
+    std::string m_text_pool;
+
+    // line_count() + 1 entries
+    std::vector<uint32_t> m_line_first_word;
+
+    std::vector<int64_t> m_word_start_ms;
+
+    std::vector<uint32_t> m_word_offset;
+
+    std::vector<uint32_t> m_word_length;
+
+    std::vector<int64_t> m_word_end_ms;
+
+    std::vector<uint32_t> m_word_codepoint_offset;
+
+    std::vector<uint32_t> m_word_codepoint_length;
+
+    bool m_is_enhanced{false};
+};
+}
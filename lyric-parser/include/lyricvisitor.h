@@ -0,0 +1,60 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace AudioToolKits
+{
+struct LyricDiagnostic
+{
+    enum class Kind
+    {
+        // nothing to parse
+        EmptyInput,
+        // a text line starting before the previous one, LyricParser sorts these
+        OutOfOrder,
+        // neither a tag nor a text line, the parse ends here
+        Stopped
+    };
+
+    Kind m_kind{Kind::EmptyInput};
+
+    // index among the input lines, blank lines of a buffer are not counted
+    size_t m_line{0};
+
+    // the offending line, borrowed like every other view of the parse
+    std::string_view m_text;
+};
+
+// Parse events in input order, see LyricParser::visit_lrc(). Views borrow from
+// the input or the parser and are only valid during the call. Words of an
+// enhanced line come between on_line_begin and on_line_end, their offsets
+// index the text passed to on_line_end.
+class LyricVisitor
+{
+public:
+    virtual ~LyricVisitor() = default;
+
+    virtual void on_tag(std::string_view)
+    {
+    }
+
+    virtual void on_line_begin(int64_t)
+    {
+    }
+
+    virtual void on_word(int64_t, uint32_t, std::string_view)
+    {
+    }
+
+    virtual void on_line_end(int64_t, std::string_view)
+    {
+    }
+
+    virtual void on_diagnostic(const LyricDiagnostic&)
+    {
+    }
+};
+}
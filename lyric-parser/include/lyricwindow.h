@@ -0,0 +1,53 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <lyrictimeline.h>
+
+namespace AudioToolKits
+{
+// Difference between two consecutive visible windows, each side of a
+// contiguous window can gain or lose a run of lines, so at most two ranges.
+struct LyricWindowChange
+{
+    LyricLineRange m_window;
+
+    LyricLineRange m_entered[2];
+
+    LyricLineRange m_left[2];
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_entered[0].empty() && m_entered[1].empty() &&
+               m_left[0].empty() && m_left[1].empty();
+    }
+};
+
+// Sliding visible window over a LyricTimeline for scrolling lyric views.
+// Each update reports only the lines entering and leaving the window.
+class LyricWindowTracker
+{
+public:
+    LyricWindowTracker(const LyricTimeline& timeline
+                       , size_t context_before
+                       , size_t context_after);
+
+    LyricWindowChange update(int64_t begin_ms, int64_t end_ms);
+
+    [[nodiscard]] LyricLineRange window() const
+    {
+        return m_window;
+    }
+
+    void reset();
+
+private:
+    const LyricTimeline* m_timeline;
+
+    size_t m_context_before;
+
+    size_t m_context_after;
+
+    LyricLineRange m_window;
+};
+}
@@ -0,0 +1,58 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace AudioToolKits
+{
+// Read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(std::string_view file_path);
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    bool open(std::string_view file_path);
+
+    void close();
+
+    [[nodiscard]] bool is_open() const
+    {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]] const char* data() const
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    const char* m_data{nullptr};
+
+    size_t m_size{0};
+
+#if defined (_WIN32) || defined(_WIN64)
+    void* m_file_handle{nullptr};
+
+    void* m_mapping_handle{nullptr};
+#endif
+};
+}
@@ -0,0 +1,106 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace AudioToolKits
+{
+// Bounded wait-free single-producer single-consumer ring buffer.
+// All storage is allocated by the constructor, push and pop never allocate.
+template <typename T>
+class SpscQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>
+                  , "SpscQueue elements are copied across threads");
+
+public:
+    // capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        m_mask = size - 1;
+        m_buffer = std::make_unique<T[]>(size);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+
+    SpscQueue(SpscQueue&&) = delete;
+
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    ~SpscQueue() = default;
+
+    // producer thread only, false when full
+    bool try_push(const T& value) noexcept
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache > m_mask)
+        {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache > m_mask)
+            {
+                return false;
+            }
+        }
+        m_buffer[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer thread only, false when empty
+    bool try_pop(T& value) noexcept
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail_cache)
+        {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache)
+            {
+                return false;
+            }
+        }
+        value = m_buffer[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+
+    // approximate when called concurrently with push or pop
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t s_cache_line{64};
+
+    std::unique_ptr<T[]> m_buffer;
+
+    size_t m_mask{0};
+
+    // producer side
+    alignas(s_cache_line) std::atomic<size_t> m_tail{0};
+
+    size_t m_head_cache{0};
+
+    // consumer side
+    alignas(s_cache_line) std::atomic<size_t> m_head{0};
+
+    size_t m_tail_cache{0};
+};
+}
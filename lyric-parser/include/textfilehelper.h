@@ -3,6 +3,7 @@
 //
 #pragma once
 #include <filesystem>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -16,7 +17,8 @@ enum class Encoding
 class TextFileHelper
 {
 public:
-    explicit TextFileHelper(std::string_view filePath);
+    explicit TextFileHelper(std::string_view filePath
+                            , std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     TextFileHelper(const TextFileHelper&) = delete;
 
@@ -31,12 +33,28 @@ public:
     void load_file(std::string_view file_path);
 
     [[nodiscard]] std::vector<std::string> get_content() const
+    {
+        return {m_content.begin(), m_content.end()};
+    }
+
+    // the lines as read, trimmed with blank lines skipped as split_lines()
+    // does, allocated from the resource given at construction
+    [[nodiscard]] const std::pmr::vector<std::pmr::string>& content() const
     {
         return m_content;
     }
 
     static bool is_ascii(const std::string& str);
 
+    // strict UTF-8, bytes that fail are taken for GBK
+    static bool is_utf8(std::string_view str);
+
+    // whole file as raw bytes, false if it cannot be read
+    static bool read_bytes(const std::filesystem::path& file_path, std::string& out);
+
+    // trimmed lines of an in-memory file, blank lines (also "\r") are skipped
+    static std::vector<std::string> split_lines(std::string_view bytes);
+
     static std::string encoding_to_string(const Encoding& encoding);
 
     [[nodiscard]] std::string file_name() const;
@@ -47,12 +65,14 @@ public:
 
     static void trim_string(std::string& str);
 
+    static void trim_string(std::pmr::string& str);
+
     static bool is_English(std::string_view str);
 
 private:
     std::filesystem::path m_path;
 
-    std::vector<std::string> m_content;
+    std::pmr::vector<std::pmr::string> m_content;
 
     bool read_file();
 
@@ -0,0 +1,191 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricasync.h>
+#include <lyricscheduler.h>
+#include <textfilehelper.h>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+namespace AudioToolKits
+{
+LyricCancelToken::LyricCancelToken()
+    : m_cancelled{std::make_shared<std::atomic<bool>>(false)}
+{
+}
+
+void LyricCancelToken::cancel() const
+{
+    m_cancelled->store(true, std::memory_order_release);
+}
+
+bool LyricCancelToken::is_cancelled() const
+{
+    return m_cancelled->load(std::memory_order_acquire);
+}
+
+LyricAsyncLoader::LyricAsyncLoader(Executor work_executor)
+    : m_work_executor{std::move(work_executor)}
+{
+}
+
+LyricAsyncLoader::LyricAsyncLoader(LyricWorkStealingPool& pool)
+    : LyricAsyncLoader([&pool](Task task)
+    {
+        pool.submit(std::move(task));
+    })
+{
+}
+
+std::future<LyricLoadResult> LyricAsyncLoader::load_file(std::string file_path, LyricCancelToken token)
+{
+    return submit([file_path = std::move(file_path), token]()
+    {
+        return load_file_now(file_path, token);
+    });
+}
+
+void LyricAsyncLoader::load_file(std::string file_path
+                                 , LyricCancelToken token
+                                 , Executor callback_executor
+                                 , Callback callback)
+{
+    submit([file_path = std::move(file_path), token]()
+           {
+               return load_file_now(file_path, token);
+           }
+           , token
+           , std::move(callback_executor)
+           , std::move(callback));
+}
+
+std::future<LyricLoadResult> LyricAsyncLoader::parse_buffer(std::string utf8_bytes, LyricCancelToken token)
+{
+    return submit([utf8_bytes = std::move(utf8_bytes), token]()
+    {
+        return parse_buffer_now(utf8_bytes, token);
+    });
+}
+
+void LyricAsyncLoader::parse_buffer(std::string utf8_bytes
+                                    , LyricCancelToken token
+                                    , Executor callback_executor
+                                    , Callback callback)
+{
+    submit([utf8_bytes = std::move(utf8_bytes), token]()
+           {
+               return parse_buffer_now(utf8_bytes, token);
+           }
+           , token
+           , std::move(callback_executor)
+           , std::move(callback));
+}
+
+LyricLoadResult LyricAsyncLoader::load_file_now(const std::string& file_path, const LyricCancelToken& token)
+{
+    // 1. Read, skipped for a load cancelled while it was queued
+    if (token.is_cancelled())
+    {
+        return {LyricLoadStatus::Cancelled, nullptr};
+    }
+    std::string bytes;
+    if (!TextFileHelper::read_bytes(file_path, bytes))
+    {
+        return {LyricLoadStatus::Failed, nullptr};
+    }
+    // 1.
+
+    // 2. Decode
+    if (token.is_cancelled())
+    {
+        return {LyricLoadStatus::Cancelled, nullptr};
+    }
+    if (!TextFileHelper::is_utf8(bytes))
+    {
+        bytes = TextFileHelper::convert_encoding(bytes, Encoding::GBK, Encoding::UTF8);
+    }
+    // 2.
+
+    // 3. Parse
+    return parse_buffer_now(bytes, token);
+    // 3.
+}
+
+LyricLoadResult LyricAsyncLoader::parse_buffer_now(const std::string_view utf8_bytes
+                                                   , const LyricCancelToken& token)
+{
+    if (token.is_cancelled())
+    {
+        return {LyricLoadStatus::Cancelled, nullptr};
+    }
+    auto parser = std::make_shared<LyricParser>();
+    parser->parse_buffer(utf8_bytes);
+    if (token.is_cancelled())
+    {
+        return {LyricLoadStatus::Cancelled, nullptr};
+    }
+    // an empty file or bytes that are not LRC, as the ingest pipeline judges it
+    if (parser->line_count() == 0)
+    {
+        return {LyricLoadStatus::Failed, nullptr};
+    }
+    return {LyricLoadStatus::Loaded, std::move(parser)};
+}
+
+std::future<LyricLoadResult> LyricAsyncLoader::submit(std::function<LyricLoadResult()> work)
+{
+    // std::function needs a copyable task, the promise is shared
+    auto promise = std::make_shared<std::promise<LyricLoadResult>>();
+    auto future = promise->get_future();
+    m_work_executor([promise, work = std::move(work)]()
+    {
+        // e.g. std::bad_alloc, rethrown by future.get() instead of escaping
+        // into the executor
+        try
+        {
+            promise->set_value(work());
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+void LyricAsyncLoader::submit(std::function<LyricLoadResult()> work
+                              , LyricCancelToken token
+                              , Executor callback_executor
+                              , Callback callback)
+{
+    m_work_executor([work = std::move(work)
+                        , token = std::move(token)
+                        , callback_executor = std::move(callback_executor)
+                        , callback = std::move(callback)]()
+    {
+        auto result = std::make_shared<LyricLoadResult>();
+        try
+        {
+            *result = work();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "LyricAsyncLoader: load failed: " << e.what() << std::endl;
+        }
+        catch (...)
+        {
+            std::cerr << "LyricAsyncLoader: load failed with an unknown exception" << std::endl;
+        }
+        callback_executor([result, token, callback]()
+        {
+            // a skip may land after the parse, while the callback was queued
+            if (token.is_cancelled())
+            {
+                *result = LyricLoadResult{LyricLoadStatus::Cancelled, nullptr};
+            }
+            callback(std::move(*result));
+        });
+    });
+}
+}
@@ -0,0 +1,122 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricbatch.h>
+#include <algorithm>
+#include <utility>
+
+namespace AudioToolKits
+{
+LyricBatchResolver::LyricBatchResolver(std::vector<const LyricTimeline*> documents)
+    : m_documents{std::move(documents)}
+{
+}
+
+void LyricBatchResolver::merge_sorted(const std::vector<int64_t>& starts
+                                      , const std::vector<LyricTimeQuery>& queries
+                                      , const std::vector<uint32_t>::const_iterator begin
+                                      , const std::vector<uint32_t>::const_iterator end
+                                      , std::vector<uint32_t>& lines)
+{
+    const auto line_count = static_cast<uint32_t>(starts.size());
+    // number of lines started at or before the current query time
+    uint32_t started = 0;
+    for (auto it = begin; it != end; ++it)
+    {
+        const int64_t time_ms = queries[*it].m_time_ms;
+        // sparse queries gallop instead of walking every line
+        uint32_t step = 1;
+        while (started + step <= line_count && starts[started + step - 1] <= time_ms)
+        {
+            started += step;
+            step <<= 1;
+        }
+        started = static_cast<uint32_t>(
+            std::upper_bound(starts.begin() + started
+                             , starts.begin() + std::min(started + step, line_count)
+                             , time_ms) - starts.begin());
+        if (started > 0)
+        {
+            lines[*it] = started - 1;
+        }
+    }
+}
+
+void LyricBatchResolver::resolve(const std::vector<LyricTimeQuery>& queries
+                                 , std::vector<uint32_t>& lines)
+{
+    const size_t document_count = m_documents.size();
+    lines.assign(queries.size(), LyricLineCursor::s_none);
+
+    // 1. Counting sort of query indices by document
+    m_bucket_begin.assign(document_count + 1, 0);
+    for (const auto& query : queries)
+    {
+        if (query.m_document < document_count)
+        {
+            ++m_bucket_begin[query.m_document + 1];
+        }
+    }
+    for (size_t d = 0; d < document_count; ++d)
+    {
+        m_bucket_begin[d + 1] += m_bucket_begin[d];
+    }
+    m_order.resize(m_bucket_begin[document_count]);
+    {
+        std::vector<uint32_t> fill(m_bucket_begin.begin(), m_bucket_begin.end() - 1);
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            if (queries[i].m_document < document_count)
+            {
+                m_order[fill[queries[i].m_document]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+    // 1.
+
+    // 2. Per document, merge sorted runs, branchless binary search otherwise
+    for (size_t d = 0; d < document_count; ++d)
+    {
+        const auto begin = m_order.begin() + m_bucket_begin[d];
+        const auto end = m_order.begin() + m_bucket_begin[d + 1];
+        if (begin == end || m_documents[d] == nullptr)
+        {
+            continue;
+        }
+        const auto& starts = m_documents[d]->line_starts();
+        const auto line_count = static_cast<uint32_t>(starts.size());
+        if (line_count == 0)
+        {
+            continue;
+        }
+        const auto by_time = [&queries](const uint32_t a, const uint32_t b)
+        {
+            return queries[a].m_time_ms < queries[b].m_time_ms;
+        };
+        if (std::is_sorted(begin, end, by_time))
+        {
+            merge_sorted(starts, queries, begin, end, lines);
+            continue;
+        }
+        for (auto it = begin; it != end; ++it)
+        {
+            const int64_t time_ms = queries[*it].m_time_ms;
+            const int64_t* base = starts.data();
+            uint32_t size = line_count;
+            while (size > 1)
+            {
+                const uint32_t half = size / 2;
+                base = base[half] <= time_ms ? base + half : base;
+                size -= half;
+            }
+            const auto started = static_cast<uint32_t>(base - starts.data()) +
+                                 (*base <= time_ms ? 1 : 0);
+            if (started > 0)
+            {
+                lines[*it] = started - 1;
+            }
+        }
+    }
+    // 2.
+}
+}
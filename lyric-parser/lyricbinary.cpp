@@ -0,0 +1,344 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricbinary.h>
+#include "binaryio.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace AudioToolKits
+{
+namespace
+{
+constexpr size_t s_align{8};
+
+constexpr size_t s_string_entry_size{8};
+
+constexpr size_t s_word_entry_size{24};
+
+uint32_t append_pool(std::string& pool, const std::string_view str)
+{
+    const auto offset = static_cast<uint32_t>(pool.size());
+    pool.append(str);
+    return offset;
+}
+}
+
+std::string LyricCompiler::compile(const LyricParser& parser)
+{
+    using namespace BinaryIO;
+    const auto tags = parser.get_tags();
+    const auto lines = parser.get_text();
+    const auto& words = parser.get_words();
+
+    // 1. String pool and seek index
+    std::string pool;
+    std::vector<uint32_t> tag_offsets;
+    std::vector<uint32_t> line_offsets;
+    for (const auto& tag : tags)
+    {
+        tag_offsets.push_back(append_pool(pool, tag));
+    }
+    for (const auto& line : lines)
+    {
+        line_offsets.push_back(append_pool(pool, line.m_text));
+    }
+
+    const bool sorted = std::is_sorted(lines.begin()
+                                       , lines.end()
+                                       , [](const LyricLine& a
+                                            , const LyricLine& b)
+                                       {
+                                           return a.start_ms() < b.start_ms();
+                                       });
+    uint32_t seek_step_ms{0};
+    std::vector<uint32_t> seek;
+    if (sorted && !lines.empty() && lines.back().start_ms() >= 0)
+    {
+        const int64_t last_ms = lines.back().start_ms();
+        // roughly one line per bucket, the step stays a u32 for sparse
+        // multi-day timelines
+        seek_step_ms = static_cast<uint32_t>(std::clamp<int64_t>(
+            last_ms / static_cast<int64_t>(lines.size()) + 1, 100, UINT32_MAX));
+        const size_t seek_count = static_cast<size_t>(last_ms / seek_step_ms) + 1;
+        size_t line_index = 0;
+        for (size_t k = 0; k < seek_count; ++k)
+        {
+            const int64_t bucket_ms = static_cast<int64_t>(k) * seek_step_ms;
+            while (line_index < lines.size() &&
+                   lines[line_index].start_ms() <= bucket_ms)
+            {
+                ++line_index;
+            }
+            seek.push_back(static_cast<uint32_t>(line_index));
+        }
+    }
+    // 1.
+
+    // 2. Header, patched with section offsets below
+    std::string out(LyricBinaryView::s_header_size, '\0');
+    std::memcpy(out.data(), LyricBinaryView::s_magic, sizeof(LyricBinaryView::s_magic));
+    uint16_t flags{0};
+    if (parser.is_enhanced())
+    {
+        flags |= LyricBinaryView::Enhanced;
+    }
+    if (sorted)
+    {
+        flags |= LyricBinaryView::Sorted;
+    }
+    patch_u16(out, LyricBinaryView::Version, LyricBinaryView::s_version);
+    patch_u16(out, LyricBinaryView::FlagBits, flags);
+    patch_u32(out, LyricBinaryView::HeaderSize, LyricBinaryView::s_header_size);
+    patch_u32(out, LyricBinaryView::TagCount, static_cast<uint32_t>(tags.size()));
+    patch_u32(out, LyricBinaryView::LineCount, static_cast<uint32_t>(lines.size()));
+    patch_u32(out, LyricBinaryView::WordCount, static_cast<uint32_t>(words.size()));
+    patch_u32(out, LyricBinaryView::SeekStepMs, seek_step_ms);
+    patch_u32(out, LyricBinaryView::SeekCount, static_cast<uint32_t>(seek.size()));
+    // 2.
+
+    // 3. Sections
+    patch_u32(out, LyricBinaryView::TagsOffset, static_cast<uint32_t>(out.size()));
+    for (size_t i = 0; i < tags.size(); ++i)
+    {
+        put_u32(out, tag_offsets[i]);
+        put_u32(out, static_cast<uint32_t>(tags[i].size()));
+    }
+    align_to(out, s_align);
+
+    patch_u32(out, LyricBinaryView::TimesOffset, static_cast<uint32_t>(out.size()));
+    for (const auto& line : lines)
+    {
+        put_i64(out, line.start_ms());
+    }
+
+    patch_u32(out, LyricBinaryView::LinesOffset, static_cast<uint32_t>(out.size()));
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        put_u32(out, line_offsets[i]);
+        put_u32(out, static_cast<uint32_t>(lines[i].m_text.size()));
+    }
+    align_to(out, s_align);
+
+    patch_u32(out, LyricBinaryView::WordsOffset, static_cast<uint32_t>(out.size()));
+    for (const auto& word : words)
+    {
+        put_i64(out, word.m_start_ms);
+        put_u32(out, word.m_line);
+        put_u32(out, word.m_offset);
+        put_u32(out, word.m_length);
+        put_u32(out, 0);
+    }
+
+    patch_u32(out, LyricBinaryView::SeekOffset, static_cast<uint32_t>(out.size()));
+    for (const auto entry : seek)
+    {
+        put_u32(out, entry);
+    }
+    align_to(out, s_align);
+
+    patch_u32(out, LyricBinaryView::PoolOffset, static_cast<uint32_t>(out.size()));
+    patch_u32(out, LyricBinaryView::PoolSize, static_cast<uint32_t>(pool.size()));
+    out.append(pool);
+    align_to(out, s_align);
+    patch_u32(out, LyricBinaryView::TotalSize, static_cast<uint32_t>(out.size()));
+    // 3.
+    return out;
+}
+
+bool LyricCompiler::compile_to_file(const LyricParser& parser
+                                    , const std::string_view file_path)
+{
+    const std::string bytes = compile(parser);
+    std::ofstream out_stream(std::string{file_path}
+                             , std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!out_stream.is_open())
+    {
+        std::cerr << "LyricCompiler::compile_to_file: failed to open " <<
+                file_path << std::endl;
+        return false;
+    }
+    out_stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out_stream);
+}
+
+LyricBinaryView::LyricBinaryView(const char* data, const size_t size)
+{
+    using namespace BinaryIO;
+    if (data == nullptr || size < s_header_size ||
+        std::memcmp(data, s_magic, sizeof(s_magic)) != 0)
+    {
+        std::cerr << "LyricBinaryView: not a compiled lyric" << std::endl;
+        return;
+    }
+    if (load_u16(data + Version) != s_version)
+    {
+        std::cerr << "LyricBinaryView: unsupported version " <<
+                load_u16(data + Version) << std::endl;
+        return;
+    }
+    if (load_u32(data + TotalSize) > size)
+    {
+        std::cerr << "LyricBinaryView: truncated data" << std::endl;
+        return;
+    }
+
+    const uint32_t tag_count = load_u32(data + TagCount);
+    const uint32_t line_count = load_u32(data + LineCount);
+    const uint32_t word_count = load_u32(data + WordCount);
+    const uint32_t seek_count = load_u32(data + SeekCount);
+    const uint32_t pool_offset = load_u32(data + PoolOffset);
+    const uint32_t pool_size = load_u32(data + PoolSize);
+
+    const auto fits = [size](const uint64_t offset, const uint64_t bytes)
+    {
+        return offset + bytes <= size;
+    };
+    if (!fits(load_u32(data + TagsOffset), uint64_t{tag_count} * s_string_entry_size) ||
+        !fits(load_u32(data + TimesOffset), uint64_t{line_count} * sizeof(int64_t)) ||
+        !fits(load_u32(data + LinesOffset), uint64_t{line_count} * s_string_entry_size) ||
+        !fits(load_u32(data + WordsOffset), uint64_t{word_count} * s_word_entry_size) ||
+        !fits(load_u32(data + SeekOffset), uint64_t{seek_count} * sizeof(uint32_t)) ||
+        !fits(pool_offset, pool_size))
+    {
+        std::cerr << "LyricBinaryView: section out of bounds" << std::endl;
+        return;
+    }
+
+    m_data = data;
+    m_size = size;
+    m_flags = load_u16(data + FlagBits);
+    m_tag_count = tag_count;
+    m_line_count = line_count;
+    m_word_count = word_count;
+    m_seek_step_ms = load_u32(data + SeekStepMs);
+    m_seek_count = m_seek_step_ms == 0 ? 0 : seek_count;
+    m_tags = data + load_u32(data + TagsOffset);
+    m_times = data + load_u32(data + TimesOffset);
+    m_lines = data + load_u32(data + LinesOffset);
+    m_words = data + load_u32(data + WordsOffset);
+    m_seek = data + load_u32(data + SeekOffset);
+    m_pool = data + pool_offset;
+    m_pool_size = pool_size;
+}
+
+bool LyricBinaryView::is_enhanced() const
+{
+    return (m_flags & Enhanced) != 0;
+}
+
+std::string_view LyricBinaryView::tag(const size_t index) const
+{
+    return pool_string(m_tags + index * s_string_entry_size);
+}
+
+int64_t LyricBinaryView::start_ms(const size_t index) const
+{
+    return BinaryIO::load_i64(m_times + index * sizeof(int64_t));
+}
+
+std::string_view LyricBinaryView::text(const size_t index) const
+{
+    return pool_string(m_lines + index * s_string_entry_size);
+}
+
+LyricWord LyricBinaryView::word(const size_t index) const
+{
+    using namespace BinaryIO;
+    const char* entry = m_words + index * s_word_entry_size;
+    return LyricWord{load_i64(entry), load_u32(entry + 8), load_u32(entry + 12), load_u32(entry + 16)};
+}
+
+std::optional<size_t> LyricBinaryView::find_line(const int64_t time_ms) const
+{
+    if (m_line_count == 0 || time_ms < start_ms(0))
+    {
+        return std::nullopt;
+    }
+    size_t index = 0;
+    if ((m_flags & Sorted) != 0 && m_seek_count > 0)
+    {
+        // the lines started by time_ms are counted between the entries of its
+        // bucket and the next one, binary search in between so dense buckets
+        // stay logarithmic
+        const size_t bucket = time_ms < 0
+                                  ? 0
+                                  : std::min<size_t>(static_cast<size_t>(time_ms / m_seek_step_ms)
+                                                     , m_seek_count - 1);
+        size_t first = time_ms < 0 ? 0 : BinaryIO::load_u32(m_seek + bucket * sizeof(uint32_t));
+        size_t last = bucket + 1 < m_seek_count
+                          ? BinaryIO::load_u32(m_seek + (bucket + 1) * sizeof(uint32_t))
+                          : m_line_count;
+        first = std::min<size_t>(first, m_line_count);
+        last = std::clamp<size_t>(last, first, m_line_count);
+        while (first < last)
+        {
+            const size_t middle = first + (last - first) / 2;
+            if (start_ms(middle) <= time_ms)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+        return first - 1;
+    }
+    // unsorted input, the last line that has started wins
+    std::optional<size_t> result;
+    for (; index < m_line_count; ++index)
+    {
+        if (start_ms(index) <= time_ms &&
+            (!result || start_ms(index) >= start_ms(*result)))
+        {
+            result = index;
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> LyricBinaryView::get_tags() const
+{
+    std::vector<std::string> tags;
+    tags.reserve(m_tag_count);
+    for (size_t i = 0; i < m_tag_count; ++i)
+    {
+        tags.emplace_back(tag(i));
+    }
+    return tags;
+}
+
+std::vector<LyricLine> LyricBinaryView::get_text() const
+{
+    std::vector<LyricLine> lines;
+    lines.reserve(m_line_count);
+    for (size_t i = 0; i < m_line_count; ++i)
+    {
+        lines.emplace_back(start_ms(i), std::string{text(i)});
+    }
+    return lines;
+}
+
+std::string_view LyricBinaryView::pool_string(const char* entry) const
+{
+    const uint32_t offset = BinaryIO::load_u32(entry);
+    const uint32_t length = BinaryIO::load_u32(entry + 4);
+    if (uint64_t{offset} + length > m_pool_size)
+    {
+        return {};
+    }
+    return {m_pool + offset, length};
+}
+
+LyricBinaryReader::LyricBinaryReader(const std::string_view file_path)
+{
+    if (m_file.open(file_path))
+    {
+        static_cast<LyricBinaryView&>(*this) =
+                LyricBinaryView{m_file.data(), m_file.size()};
+    }
+}
+}
@@ -0,0 +1,219 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyriccache.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <system_error>
+
+namespace AudioToolKits
+{
+LyricCache::LyricCache(const size_t byte_budget, const size_t shard_count)
+    : m_byte_budget{byte_budget},
+      m_shard_budget{byte_budget / std::max<size_t>(shard_count, 1)}
+{
+    m_shards.reserve(std::max<size_t>(shard_count, 1));
+    for (size_t i = 0; i < std::max<size_t>(shard_count, 1); ++i)
+    {
+        m_shards.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+LyricCache::~LyricCache() = default;
+
+LyricCache::Document LyricCache::get_file(const std::string_view file_path)
+{
+    const std::filesystem::path path{file_path};
+    std::error_code ec;
+    FileStamp stamp;
+    stamp.m_mtime = std::filesystem::last_write_time(path, ec);
+    if (!ec)
+    {
+        stamp.m_size = std::filesystem::file_size(path, ec);
+    }
+    if (ec)
+    {
+        std::cerr << "LyricCache::get_file: cannot stat " << path << ": " <<
+                ec.message() << std::endl;
+        return std::make_shared<const LyricParser>(file_path);
+    }
+
+    const std::string key = "file:" + path.string();
+    return get_or_load(key
+                       , stamp
+                       , [&file_path]()
+                       {
+                           return std::make_shared<const LyricParser>(file_path);
+                       });
+}
+
+LyricCache::Document LyricCache::get_content(
+    const std::vector<std::string>& file_content)
+{
+    const std::string key = "hash:" + std::to_string(content_hash(file_content));
+    return get_or_load(key
+                       , FileStamp{}
+                       , [&file_content]()
+                       {
+                           auto parser = std::make_shared<LyricParser>();
+                           parser->parse_lrc(file_content);
+                           return Document{std::move(parser)};
+                       });
+}
+
+void LyricCache::erase_file(const std::string_view file_path)
+{
+    const std::string key = "file:" + std::filesystem::path{file_path}.string();
+    Shard& shard = shard_for(key);
+    const std::lock_guard<std::mutex> lock(shard.m_mutex);
+    if (const auto it = shard.m_index.find(key); it != shard.m_index.end())
+    {
+        erase_locked(shard, it->second);
+    }
+}
+
+void LyricCache::clear()
+{
+    for (const auto& shard : m_shards)
+    {
+        const std::lock_guard<std::mutex> lock(shard->m_mutex);
+        shard->m_lru.clear();
+        shard->m_index.clear();
+        shard->m_bytes = 0;
+    }
+}
+
+LyricCacheStats LyricCache::stats() const
+{
+    LyricCacheStats result;
+    for (const auto& shard : m_shards)
+    {
+        const std::lock_guard<std::mutex> lock(shard->m_mutex);
+        result.m_hits += shard->m_hits;
+        result.m_misses += shard->m_misses;
+        result.m_evictions += shard->m_evictions;
+        result.m_loads += shard->m_loads;
+        result.m_entries += shard->m_lru.size();
+        result.m_bytes += shard->m_bytes;
+    }
+    return result;
+}
+
+size_t LyricCache::byte_budget() const
+{
+    return m_byte_budget;
+}
+
+uint64_t LyricCache::content_hash(const std::vector<std::string>& file_content)
+{
+    // FNV-1a, lines are separated by '\n' so {"ab"} and {"a", "b"} differ
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& line : file_content)
+    {
+        for (const char c : line)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        hash ^= static_cast<unsigned char>('\n');
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename Loader>
+LyricCache::Document LyricCache::get_or_load(const std::string& key
+                                             , const FileStamp& stamp
+                                             , Loader&& loader)
+{
+    Shard& shard = shard_for(key);
+    std::unique_lock<std::mutex> lock(shard.m_mutex);
+
+    // 1. Cache lookup
+    if (const auto it = shard.m_index.find(key); it != shard.m_index.end())
+    {
+        if (it->second->m_stamp == stamp)
+        {
+            shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second);
+            ++shard.m_hits;
+            return it->second->m_document;
+        }
+        // the file changed on disk since it was cached
+        erase_locked(shard, it->second);
+    }
+    ++shard.m_misses;
+    // 1.
+
+    // 2. Single-flight, join a load already in progress
+    if (const auto it = shard.m_loading.find(key); it != shard.m_loading.end())
+    {
+        const std::shared_future<Document> pending = it->second;
+        lock.unlock();
+        return pending.get();
+    }
+    std::promise<Document> promise;
+    shard.m_loading.emplace(key, promise.get_future().share());
+    ++shard.m_loads;
+    lock.unlock();
+    // 2.
+
+    // 3. Parse outside the lock, then publish
+    Document document;
+    try
+    {
+        document = loader();
+    }
+    catch (...)
+    {
+        lock.lock();
+        shard.m_loading.erase(key);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    shard.m_loading.erase(key);
+    insert_locked(shard, key, stamp, document);
+    lock.unlock();
+    promise.set_value(document);
+    // 3.
+    return document;
+}
+
+LyricCache::Shard& LyricCache::shard_for(const std::string& key)
+{
+    return *m_shards[std::hash<std::string>{}(key) % m_shards.size()];
+}
+
+void LyricCache::insert_locked(Shard& shard
+                               , const std::string& key
+                               , const FileStamp& stamp
+                               , const Document& document)
+{
+    const size_t bytes = sizeof(Entry) + key.capacity() +
+                         document->memory_usage();
+    if (bytes > m_shard_budget)
+    {
+        // larger than the whole shard, hand it out without caching
+        return;
+    }
+    shard.m_lru.push_front(Entry{key, stamp, document, bytes});
+    shard.m_index[key] = shard.m_lru.begin();
+    shard.m_bytes += bytes;
+
+    while (shard.m_bytes > m_shard_budget)
+    {
+        erase_locked(shard, std::prev(shard.m_lru.end()));
+        ++shard.m_evictions;
+    }
+}
+
+void LyricCache::erase_locked(Shard& shard, const std::list<Entry>::iterator it)
+{
+    shard.m_bytes -= it->m_bytes;
+    shard.m_index.erase(it->m_key);
+    shard.m_lru.erase(it);
+}
+}
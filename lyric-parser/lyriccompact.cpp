@@ -0,0 +1,132 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyriccompact.h>
+#include <iostream>
+#include <unordered_map>
+
+namespace AudioToolKits
+{
+LyricCompactStore::LyricCompactStore()
+    : m_first_line{0}
+{
+}
+
+uint32_t LyricCompactStore::add(const std::vector<LyricLine>& lines)
+{
+    // 1. Check the 32-bit limits before touching the store
+    size_t text_bytes{0};
+    for (const auto& line : lines)
+    {
+        if (line.isText() && (line.start_ms() < 0 || line.start_ms() >= LyricCompactLine::s_tag))
+        {
+            std::cerr << "LyricCompactStore::add: time out of range: " << line.start_ms() << "\n";
+            return npos;
+        }
+        text_bytes += line.m_text.size();
+    }
+    if (m_pool.size() + text_bytes > UINT32_MAX ||
+        m_lines.size() + lines.size() >= UINT32_MAX ||
+        document_count() + 1 >= npos)
+    {
+        std::cerr << "LyricCompactStore::add: store is full\n";
+        return npos;
+    }
+    // 1.
+
+    // 2. Append, repeated lines of the document (choruses) share their pool bytes
+    std::unordered_map<std::string_view, uint32_t> seen;
+    for (const auto& line : lines)
+    {
+        LyricCompactLine compact;
+        if (line.isText())
+        {
+            compact.m_start_ms = static_cast<uint32_t>(line.start_ms());
+        }
+        const auto [it, inserted] = seen.emplace(line.m_text
+                                                 , static_cast<uint32_t>(m_pool.size()));
+        if (inserted)
+        {
+            m_pool.append(line.m_text);
+        }
+        compact.m_offset = it->second;
+        compact.m_length = static_cast<uint32_t>(line.m_text.size());
+        m_lines.push_back(compact);
+    }
+    m_first_line.push_back(static_cast<uint32_t>(m_lines.size()));
+    // 2.
+    return static_cast<uint32_t>(document_count() - 1);
+}
+
+uint32_t LyricCompactStore::add(const LyricParser& parser)
+{
+    return add(parser.get_lrc());
+}
+
+size_t LyricCompactStore::line_count(const uint32_t document) const
+{
+    return m_first_line[document + 1] - m_first_line[document];
+}
+
+const LyricCompactLine& LyricCompactStore::line(const uint32_t document
+                                                , const size_t index) const
+{
+    return m_lines[m_first_line[document] + index];
+}
+
+std::string_view LyricCompactStore::text(const LyricCompactLine& line) const
+{
+    return std::string_view{m_pool}.substr(line.m_offset, line.m_length);
+}
+
+std::vector<LyricLine> LyricCompactStore::lines(const uint32_t document) const
+{
+    std::vector<LyricLine> result;
+    result.reserve(line_count(document));
+    for (size_t i = 0; i < line_count(document); ++i)
+    {
+        const auto& compact = line(document, i);
+        if (compact.isTag())
+        {
+            result.emplace_back(text(compact));
+        }
+        else
+        {
+            result.emplace_back(compact.start_ms(), text(compact));
+        }
+    }
+    return result;
+}
+
+void LyricCompactStore::shrink_to_fit()
+{
+    m_lines.shrink_to_fit();
+    m_first_line.shrink_to_fit();
+    m_pool.shrink_to_fit();
+}
+
+size_t LyricCompactStore::memory_usage() const
+{
+    return sizeof(LyricCompactStore) +
+           m_lines.capacity() * sizeof(LyricCompactLine) +
+           m_first_line.capacity() * sizeof(uint32_t) +
+           m_pool.capacity();
+}
+
+size_t LyricCompactStore::memory_usage(const std::vector<LyricLine>& lines)
+{
+    size_t bytes = sizeof(std::vector<LyricLine>) + lines.capacity() * sizeof(LyricLine);
+    for (const auto& line : lines)
+    {
+        const auto* object_begin = reinterpret_cast<const char*>(&line.m_text);
+        const auto* object_end = object_begin + sizeof(line.m_text);
+        const bool is_sso = line.m_text.data() >= object_begin &&
+                            line.m_text.data() < object_end;
+        if (!is_sso)
+        {
+            bytes += line.m_text.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+}
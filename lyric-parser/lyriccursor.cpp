@@ -0,0 +1,78 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyriccursor.h>
+#include <algorithm>
+
+namespace AudioToolKits
+{
+size_t advance_cursors(const LyricTimeline& timeline
+                       , LyricLineCursor* cursors
+                       , const int64_t* positions_ms
+                       , const size_t count
+                       , uint8_t* changed)
+{
+    const int64_t* starts = timeline.line_starts().data();
+    const auto line_count = static_cast<uint32_t>(timeline.line_count());
+    // listeners usually move at most a line between pushes
+    constexpr uint32_t max_linear_steps{2};
+
+    size_t changed_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int64_t time_ms = positions_ms[i];
+        const uint32_t old_line = cursors[i].m_line;
+        uint32_t line = old_line;
+        if (line != LyricLineCursor::s_none && time_ms < starts[line])
+        {
+            line = LyricLineCursor::s_none;
+            // backward, search only the prefix we are known to be before
+            const auto it = std::upper_bound(starts, starts + old_line, time_ms);
+            if (it != starts)
+            {
+                line = static_cast<uint32_t>(it - starts) - 1;
+            }
+        }
+        else
+        {
+            uint32_t next = line == LyricLineCursor::s_none ? 0 : line + 1;
+            uint32_t steps = 0;
+            while (next < line_count && starts[next] <= time_ms)
+            {
+                line = next++;
+                if (++steps == max_linear_steps)
+                {
+                    const auto it = std::upper_bound(starts + next, starts + line_count, time_ms);
+                    line = static_cast<uint32_t>(it - starts) - 1;
+                    break;
+                }
+            }
+        }
+        cursors[i].m_line = line;
+        const bool moved = line != old_line;
+        changed_count += moved;
+        if (changed != nullptr)
+        {
+            changed[i] = static_cast<uint8_t>(moved);
+        }
+    }
+    return changed_count;
+}
+
+size_t advance_cursors(const LyricTimeline& timeline
+                       , std::vector<LyricLineCursor>& cursors
+                       , const std::vector<int64_t>& positions_ms
+                       , std::vector<uint8_t>* changed)
+{
+    const size_t count = std::min(cursors.size(), positions_ms.size());
+    if (changed != nullptr)
+    {
+        changed->resize(count);
+    }
+    return advance_cursors(timeline
+                           , cursors.data()
+                           , positions_ms.data()
+                           , count
+                           , changed != nullptr ? changed->data() : nullptr);
+}
+}
@@ -0,0 +1,115 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricdispatcher.h>
+#include <utility>
+
+namespace AudioToolKits
+{
+LyricPlaybackDispatcher::LyricPlaybackDispatcher(
+    std::shared_ptr<const LyricTimeline> timeline
+    , const uint32_t sample_rate
+    , const size_t queue_capacity)
+    : m_timeline{timeline ? std::move(timeline) : std::make_shared<const LyricTimeline>()},
+      m_queue{queue_capacity},
+      m_sample_rate{sample_rate}
+{
+}
+
+LyricPlaybackDispatcher::~LyricPlaybackDispatcher() = default;
+
+void LyricPlaybackDispatcher::tick(const uint64_t sample_position) noexcept
+{
+    const uint32_t sample_rate = m_sample_rate.load(std::memory_order_relaxed);
+    if (sample_rate == 0)
+    {
+        return;
+    }
+    const auto time_ms = static_cast<int64_t>(sample_position * 1000 / sample_rate);
+    const LyricTimeline& timeline = *m_timeline;
+    const auto& starts = timeline.line_starts();
+    const size_t line_count = starts.size();
+
+    // 1. Resolve the line, linear for normal playback, binary search on seeks
+    bool seeked = time_ms < m_last_ms;
+    size_t line = m_line;
+    if (seeked)
+    {
+        line = timeline.find_line(time_ms);
+    }
+    else
+    {
+        size_t next = line == LyricTimeline::npos ? 0 : line + 1;
+        size_t steps = 0;
+        while (next < line_count && starts[next] <= time_ms)
+        {
+            line = next++;
+            if (++steps == s_max_linear_steps)
+            {
+                line = timeline.find_line(time_ms);
+                seeked = true;
+                break;
+            }
+        }
+    }
+    m_last_ms = time_ms;
+    if (seeked)
+    {
+        // a seek carries the resolved line and word, no separate change events
+        m_line = line;
+        m_word = timeline.find_word(line, time_ms);
+        push(LyricPlaybackEvent::Type::Seek, time_ms);
+        return;
+    }
+    // 1.
+
+    // 2. Line and word changes
+    if (line != m_line)
+    {
+        m_line = line;
+        m_word = LyricTimeline::npos;
+        push(LyricPlaybackEvent::Type::LineChanged, time_ms);
+    }
+    if (line == LyricTimeline::npos)
+    {
+        return;
+    }
+    size_t word = m_word;
+    const size_t word_end = timeline.line_first_word(line + 1);
+    size_t next = word == LyricTimeline::npos ? timeline.line_first_word(line) : word + 1;
+    while (next < word_end && timeline.word_start_ms(next) <= time_ms)
+    {
+        word = next++;
+    }
+    if (word != m_word)
+    {
+        m_word = word;
+        push(LyricPlaybackEvent::Type::WordChanged, time_ms);
+    }
+    // 2.
+}
+
+void LyricPlaybackDispatcher::set_sample_rate(const uint32_t sample_rate) noexcept
+{
+    m_sample_rate.store(sample_rate, std::memory_order_relaxed);
+}
+
+bool LyricPlaybackDispatcher::poll(LyricPlaybackEvent& event) noexcept
+{
+    return m_queue.try_pop(event);
+}
+
+uint64_t LyricPlaybackDispatcher::dropped_events() const noexcept
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void LyricPlaybackDispatcher::push(const LyricPlaybackEvent::Type type
+                                   , const int64_t time_ms) noexcept
+{
+    if (!m_queue.try_push(LyricPlaybackEvent{type, m_line, m_word, time_ms}))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+}
@@ -0,0 +1,242 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricingest.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+namespace AudioToolKits
+{
+LyricIngestPipeline::LyricIngestPipeline(const LyricIngestConfig& config, Sink sink)
+    : m_config{config},
+      m_sink{std::move(sink)}
+{
+    m_config.m_read_threads = std::max<size_t>(m_config.m_read_threads, 1);
+    m_config.m_decode_threads = std::max<size_t>(m_config.m_decode_threads, 1);
+    m_config.m_parse_threads = std::max<size_t>(m_config.m_parse_threads, 1);
+    m_config.m_index_threads = std::max<size_t>(m_config.m_index_threads, 1);
+}
+
+LyricIngestPipeline::~LyricIngestPipeline() = default;
+
+LyricIngestStats LyricIngestPipeline::run(const std::vector<std::string>& paths)
+{
+    for (auto& counters : m_counters)
+    {
+        counters.m_items = 0;
+        counters.m_errors = 0;
+        counters.m_busy_ns = 0;
+        counters.m_depth_sum = 0;
+        counters.m_depth_samples = 0;
+        counters.m_max_depth = 0;
+    }
+    const std::array<size_t, s_stage_count> thread_counts{
+        m_config.m_read_threads
+        , m_config.m_decode_threads
+        , m_config.m_parse_threads
+        , m_config.m_index_threads
+    };
+    std::array<std::unique_ptr<Queue>, s_stage_count> queues;
+    std::array<std::atomic<size_t>, s_stage_count> live{};
+    for (size_t stage = 0; stage < s_stage_count; ++stage)
+    {
+        queues[stage] = std::make_unique<Queue>(m_config.m_queue_capacity);
+        live[stage] = thread_counts[stage];
+    }
+
+    // 1. Start every stage, the last worker of a stage closes the next queue
+    const auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t stage = 0; stage < s_stage_count; ++stage)
+    {
+        Queue* out = stage + 1 < s_stage_count ? queues[stage + 1].get() : nullptr;
+        for (size_t i = 0; i < thread_counts[stage]; ++i)
+        {
+            threads.emplace_back(&LyricIngestPipeline::worker
+                                 , this
+                                 , static_cast<Stage>(stage)
+                                 , std::ref(*queues[stage])
+                                 , out
+                                 , std::ref(live[stage]));
+        }
+    }
+    // 1.
+
+    // 2. Feed the paths, blocking while the read stage is behind
+    for (const auto& path : paths)
+    {
+        LyricIngestItem item;
+        item.m_path = path;
+        size_t depth{0};
+        queues[Read]->push(std::move(item), &depth);
+        record_depth(Read, depth);
+    }
+    queues[Read]->close();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    // 2.
+
+    // 3. Stats
+    LyricIngestStats stats;
+    stats.m_wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+    for (size_t stage = 0; stage < s_stage_count; ++stage)
+    {
+        const Counters& counters = m_counters[stage];
+        LyricStageStats& result = stats.m_stages[stage];
+        result.m_threads = thread_counts[stage];
+        result.m_items = counters.m_items;
+        result.m_errors = counters.m_errors;
+        result.m_busy_seconds = static_cast<double>(counters.m_busy_ns) / 1e9;
+        result.m_max_queue_depth = counters.m_max_depth;
+        if (counters.m_depth_samples != 0)
+        {
+            result.m_mean_queue_depth = static_cast<double>(counters.m_depth_sum) /
+                                        static_cast<double>(counters.m_depth_samples);
+        }
+        if (stats.m_wall_seconds > 0.0)
+        {
+            result.m_items_per_second = static_cast<double>(result.m_items) / stats.m_wall_seconds;
+            result.m_utilization = result.m_busy_seconds /
+                                   (static_cast<double>(result.m_threads) * stats.m_wall_seconds);
+        }
+    }
+    // 3.
+    return stats;
+}
+
+const char* LyricIngestPipeline::stage_name(const Stage stage)
+{
+    switch (stage)
+    {
+        case Read: {
+            return "read";
+        }
+        case Decode: {
+            return "decode";
+        }
+        case Parse: {
+            return "parse";
+        }
+        case Index: {
+            return "index";
+        }
+        default: {
+            return "unknown";
+        }
+    }
+}
+
+bool LyricIngestPipeline::process(const Stage stage, LyricIngestItem& item) const
+{
+    switch (stage)
+    {
+        case Read: {
+            return TextFileHelper::read_bytes(item.m_path, item.m_bytes);
+        }
+        case Decode: {
+            if (TextFileHelper::is_utf8(item.m_bytes))
+            {
+                item.m_encoding = Encoding::UTF8;
+            }
+            else
+            {
+                item.m_encoding = Encoding::GBK;
+                item.m_bytes = TextFileHelper::convert_encoding(item.m_bytes
+                                                                , Encoding::GBK
+                                                                , Encoding::UTF8);
+            }
+            item.m_lines = TextFileHelper::split_lines(item.m_bytes);
+            std::string{}.swap(item.m_bytes);
+            return !item.m_lines.empty();
+        }
+        case Parse: {
+            auto parser = std::make_shared<LyricParser>();
+            parser->parse_lrc(item.m_lines);
+            std::vector<std::string>{}.swap(item.m_lines);
+            if (parser->line_count() == 0)
+            {
+                return false;
+            }
+            item.m_document = std::move(parser);
+            return true;
+        }
+        case Index: {
+            item.m_timeline = std::make_shared<const LyricTimeline>(*item.m_document);
+            if (m_sink)
+            {
+                m_sink(std::move(item));
+            }
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void LyricIngestPipeline::worker(const Stage stage
+                                 , Queue& in
+                                 , Queue* out
+                                 , std::atomic<size_t>& live)
+{
+    Counters& counters = m_counters[stage];
+    while (auto item = in.pop())
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        // a throwing stage or sink must not end the thread, the stages around
+        // it would wait on their queues forever
+        bool ok{false};
+        try
+        {
+            ok = process(stage, *item);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "LyricIngestPipeline: " << stage_name(stage) << " stage threw: " <<
+                    e.what() << std::endl;
+        }
+        catch (...)
+        {
+            std::cerr << "LyricIngestPipeline: " << stage_name(stage) <<
+                    " stage threw an unknown exception" << std::endl;
+        }
+        counters.m_busy_ns += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count());
+        if (!ok)
+        {
+            ++counters.m_errors;
+            continue;
+        }
+        ++counters.m_items;
+        if (out != nullptr)
+        {
+            size_t depth{0};
+            out->push(std::move(*item), &depth);
+            record_depth(static_cast<Stage>(stage + 1), depth);
+        }
+    }
+    if (live.fetch_sub(1) == 1 && out != nullptr)
+    {
+        out->close();
+    }
+}
+
+void LyricIngestPipeline::record_depth(const Stage stage, const size_t depth)
+{
+    Counters& counters = m_counters[stage];
+    counters.m_depth_sum += depth;
+    ++counters.m_depth_samples;
+    size_t max_depth = counters.m_max_depth.load(std::memory_order_relaxed);
+    while (depth > max_depth &&
+           !counters.m_max_depth.compare_exchange_weak(max_depth, depth))
+    {
+    }
+}
+}
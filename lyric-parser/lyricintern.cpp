@@ -0,0 +1,175 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricintern.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <functional>
+
+namespace AudioToolKits
+{
+namespace
+{
+std::string_view trim_view(std::string_view str)
+{
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front())))
+    {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back())))
+    {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+}
+
+LyricInternTable::LyricInternTable(const size_t shard_count)
+{
+    m_shards.reserve(std::max<size_t>(shard_count, 1));
+    for (size_t i = 0; i < std::max<size_t>(shard_count, 1); ++i)
+    {
+        m_shards.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+LyricInternTable::~LyricInternTable() = default;
+
+std::string_view LyricInternTable::intern(const std::string_view str)
+{
+    const size_t hash = std::hash<std::string_view>{}(str);
+    // the set buckets on the low bits, pick the shard from the high ones
+    Shard& shard = *m_shards[(static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull >> 40) %
+                             m_shards.size()];
+    const std::lock_guard<std::mutex> lock(shard.m_mutex);
+    ++shard.m_lookups;
+    shard.m_requested_bytes += str.size();
+    if (const auto it = shard.m_strings.find(str); it != shard.m_strings.end())
+    {
+        ++shard.m_hits;
+        return *it;
+    }
+    char* storage = allocate_locked(shard, str.size());
+    std::memcpy(storage, str.data(), str.size());
+    shard.m_stored_bytes += str.size();
+    return *shard.m_strings.emplace(storage, str.size()).first;
+}
+
+LyricInternStats LyricInternTable::stats() const
+{
+    LyricInternStats stats;
+    for (const auto& shard : m_shards)
+    {
+        const std::lock_guard<std::mutex> lock(shard->m_mutex);
+        stats.m_lookups += shard->m_lookups;
+        stats.m_hits += shard->m_hits;
+        stats.m_strings += shard->m_strings.size();
+        stats.m_requested_bytes += shard->m_requested_bytes;
+        stats.m_stored_bytes += shard->m_stored_bytes;
+    }
+    return stats;
+}
+
+size_t LyricInternTable::memory_usage() const
+{
+    size_t bytes = sizeof(LyricInternTable) + m_shards.capacity() * sizeof(void*);
+    for (const auto& shard : m_shards)
+    {
+        const std::lock_guard<std::mutex> lock(shard->m_mutex);
+        // one node per string (next pointer, view, cached hash) and the bucket array
+        bytes += sizeof(Shard) +
+                 shard->m_chunk_bytes +
+                 shard->m_chunks.capacity() * sizeof(void*) +
+                 shard->m_strings.size() * (sizeof(void*) + sizeof(std::string_view) + sizeof(size_t)) +
+                 shard->m_strings.bucket_count() * sizeof(void*);
+    }
+    return bytes;
+}
+
+char* LyricInternTable::allocate_locked(Shard& shard, const size_t size)
+{
+    // strings larger than a quarter chunk get a chunk of their own
+    if (size > s_chunk_size / 4)
+    {
+        // in front of the last chunk, which keeps serving small strings
+        const auto it = shard.m_chunks.insert(shard.m_chunks.empty()
+                                                  ? shard.m_chunks.end()
+                                                  : shard.m_chunks.end() - 1
+                                              , std::make_unique<char[]>(size));
+        shard.m_chunk_bytes += size;
+        return it->get();
+    }
+    if (shard.m_chunks.empty() || shard.m_chunk_left < size)
+    {
+        shard.m_chunks.emplace_back(std::make_unique<char[]>(s_chunk_size));
+        shard.m_chunk_bytes += s_chunk_size;
+        shard.m_chunk_left = s_chunk_size;
+    }
+    char* storage = shard.m_chunks.back().get() + (s_chunk_size - shard.m_chunk_left);
+    shard.m_chunk_left -= size;
+    return storage;
+}
+
+LyricInternedDocument::LyricInternedDocument(const LyricParser& parser
+                                             , std::shared_ptr<LyricInternTable> table)
+    : m_table{table ? std::move(table) : std::make_shared<LyricInternTable>(1)}
+{
+    const auto lines = parser.get_lrc();
+    m_lines.reserve(lines.size());
+    for (const auto& line : lines)
+    {
+        LyricInternedLine interned;
+        interned.m_start_ms = line.m_start_ms;
+        interned.m_text = m_table->intern(line.m_text);
+        if (line.isTag())
+        {
+            const auto colon = interned.m_text.find(':');
+            if (colon != std::string_view::npos)
+            {
+                interned.m_key = m_table->intern(trim_view(interned.m_text.substr(0, colon)));
+            }
+        }
+        m_lines.push_back(interned);
+    }
+}
+
+std::optional<std::string_view> LyricInternedDocument::tag(const std::string_view key) const
+{
+    for (const auto& line : m_lines)
+    {
+        if (line.isText())
+        {
+            break;
+        }
+        if (line.m_key == key)
+        {
+            return trim_view(line.m_text.substr(line.m_text.find(':') + 1));
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<LyricLine> LyricInternedDocument::get_lrc() const
+{
+    std::vector<LyricLine> lines;
+    lines.reserve(m_lines.size());
+    for (const auto& line : m_lines)
+    {
+        if (line.isTag())
+        {
+            lines.emplace_back(line.m_text);
+        }
+        else
+        {
+            lines.emplace_back(*line.m_start_ms, line.m_text);
+        }
+    }
+    return lines;
+}
+
+size_t LyricInternedDocument::memory_usage() const
+{
+    return sizeof(LyricInternedDocument) + m_lines.capacity() * sizeof(LyricInternedLine);
+}
+}
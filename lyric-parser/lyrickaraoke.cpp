@@ -0,0 +1,104 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyrickaraoke.h>
+#include <algorithm>
+
+namespace AudioToolKits
+{
+namespace
+{
+float fraction(const int64_t time_ms, const int64_t begin_ms, const int64_t end_ms)
+{
+    if (end_ms <= begin_ms)
+    {
+        return time_ms >= begin_ms ? 1.0f : 0.0f;
+    }
+    const double value = static_cast<double>(time_ms - begin_ms) /
+                         static_cast<double>(end_ms - begin_ms);
+    return static_cast<float>(std::clamp(value, 0.0, 1.0));
+}
+}
+
+LyricKaraokeCursor::LyricKaraokeCursor(const LyricTimeline& timeline)
+    : m_timeline{&timeline}
+{
+}
+
+LyricKaraokeState LyricKaraokeCursor::update(const int64_t time_ms)
+{
+    const LyricTimeline& timeline = *m_timeline;
+    const size_t line_count = timeline.line_count();
+
+    // 1. Line, walk forward or search
+    size_t line = m_line;
+    if (time_ms < m_last_ms)
+    {
+        line = timeline.find_line(time_ms);
+    }
+    else
+    {
+        size_t next = line == LyricTimeline::npos ? 0 : line + 1;
+        size_t steps = 0;
+        while (next < line_count && timeline.line_start_ms(next) <= time_ms)
+        {
+            line = next++;
+            if (++steps == s_max_linear_steps)
+            {
+                line = timeline.find_line(time_ms);
+                break;
+            }
+        }
+    }
+    // 1.
+
+    // 2. Word, restart from the first word when the line changed or time went back
+    size_t word = m_word;
+    if (line != m_line || time_ms < m_last_ms)
+    {
+        word = LyricTimeline::npos;
+    }
+    if (line != LyricTimeline::npos)
+    {
+        const size_t word_end = timeline.line_first_word(line + 1);
+        size_t next = word == LyricTimeline::npos ? timeline.line_first_word(line) : word + 1;
+        while (next < word_end && timeline.word_start_ms(next) <= time_ms)
+        {
+            word = next++;
+        }
+    }
+    m_line = line;
+    m_word = word;
+    m_last_ms = time_ms;
+    // 2.
+
+    LyricKaraokeState state;
+    state.m_line = line;
+    state.m_word = word;
+    if (line == LyricTimeline::npos)
+    {
+        return state;
+    }
+    state.m_line_progress = fraction(time_ms
+                                     , timeline.line_start_ms(line)
+                                     , timeline.line_end_ms(line));
+    if (word != LyricTimeline::npos)
+    {
+        state.m_byte_offset = timeline.word_offset(word);
+        state.m_byte_length = timeline.word_length(word);
+        state.m_codepoint_offset = timeline.word_codepoint_offset(word);
+        state.m_codepoint_length = timeline.word_codepoint_length(word);
+        state.m_word_progress = fraction(time_ms
+                                         , timeline.word_start_ms(word)
+                                         , timeline.word_end_ms(word));
+    }
+    return state;
+}
+
+void LyricKaraokeCursor::reset()
+{
+    m_last_ms = INT64_MIN;
+    m_line = LyricTimeline::npos;
+    m_word = LyricTimeline::npos;
+}
+}
@@ -0,0 +1,705 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricloader.h>
+#include <textfilehelper.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#if defined (_WIN32) || defined(_WIN64)
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(LYRIC_PARSER_HAS_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#include <cstring>
+#endif
+#endif
+
+namespace AudioToolKits
+{
+namespace
+{
+#if defined(__linux__) && defined(LYRIC_PARSER_HAS_IO_URING)
+// Minimal io_uring over the raw system calls, no liburing dependency.
+class IoUring
+{
+public:
+    explicit IoUring(const unsigned entries)
+    {
+        io_uring_params params{};
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0)
+        {
+            return;
+        }
+        // 1. Map the rings, one mapping for both on kernels with SINGLE_MMAP
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap)
+        {
+            m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+        }
+        m_sq_ring = mmap(nullptr, m_sq_size, PROT_READ | PROT_WRITE
+                         , MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        m_cq_ring = single_mmap
+                        ? m_sq_ring
+                        : mmap(nullptr, m_cq_size, PROT_READ | PROT_WRITE
+                               , MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE
+                          , MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED || sqes == MAP_FAILED)
+        {
+            m_sq_ring = m_sq_ring == MAP_FAILED ? nullptr : m_sq_ring;
+            m_cq_ring = m_cq_ring == MAP_FAILED ? nullptr : m_cq_ring;
+            if (sqes != MAP_FAILED)
+            {
+                munmap(sqes, m_sqes_size);
+            }
+            release();
+            return;
+        }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+        // 1.
+
+        // 2. Ring fields
+        auto* sq = static_cast<char*>(m_sq_ring);
+        m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_entries = params.sq_entries;
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<char*>(m_cq_ring);
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        // 2.
+
+        if (!supports_ops())
+        {
+            release();
+        }
+    }
+
+    IoUring(const IoUring&) = delete;
+
+    IoUring(IoUring&&) = delete;
+
+    IoUring& operator=(const IoUring&) = delete;
+
+    IoUring& operator=(IoUring&&) = delete;
+
+    ~IoUring()
+    {
+        release();
+    }
+
+    [[nodiscard]] bool is_open() const
+    {
+        return m_fd >= 0;
+    }
+
+    // nullptr when the submission ring is full
+    io_uring_sqe* next_sqe()
+    {
+        const unsigned tail = m_local_tail;
+        if (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries)
+        {
+            return nullptr;
+        }
+        io_uring_sqe* sqe = &m_sqes[tail & m_sq_mask];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        m_sq_array[tail & m_sq_mask] = tail & m_sq_mask;
+        ++m_local_tail;
+        ++m_pending;
+        return sqe;
+    }
+
+    // io_uring_enter calls after the first after_calls fail with error_number,
+    // count times or for good when count is 0
+    void inject_error(const int error_number, const size_t after_calls, const size_t count)
+    {
+        m_fault_errno = error_number;
+        m_fault_after = after_calls;
+        m_fault_count = count;
+    }
+
+    // publishes queued entries and waits for at least one completion, false
+    // once the ring is unusable. EAGAIN and EBUSY (kernel out of resources,
+    // completion queue overflowing) return true with the entries still
+    // pending, they go out with the next call after the completions are reaped.
+    bool submit_and_wait(uint64_t& syscalls)
+    {
+        __atomic_store_n(m_sq_tail, m_local_tail, __ATOMIC_RELEASE);
+        for (size_t busy = 0;;)
+        {
+            ++syscalls;
+            const long submitted = enter(m_pending, IORING_ENTER_GETEVENTS);
+            if (submitted >= 0)
+            {
+                m_pending -= static_cast<unsigned>(submitted);
+                m_in_kernel += static_cast<unsigned>(submitted);
+                return true;
+            }
+            if ((errno == EAGAIN || errno == EBUSY) && busy++ < s_busy_retries)
+            {
+                if (has_completion())
+                {
+                    return true;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            if (errno != EINTR)
+            {
+                std::cerr << "IoUring: io_uring_enter failed: " << strerror(errno) << "\n";
+                return false;
+            }
+        }
+    }
+
+    template <typename Handler>
+    void for_each_completion(Handler&& handler)
+    {
+        unsigned head = *m_cq_head;
+        while (head != __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE))
+        {
+            const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+            handler(cqe.user_data, cqe.res);
+            ++head;
+            --m_in_kernel;
+            __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    // reaps until the kernel holds no entry that could still write to user
+    // memory, without submitting the pending ones. After a failed
+    // submit_and_wait() waiting may fail too, then the queue is polled.
+    template <typename Handler>
+    void drain(Handler&& handler, uint64_t& syscalls)
+    {
+        bool can_wait{true};
+        while (m_in_kernel != 0)
+        {
+            if (!has_completion())
+            {
+                if (can_wait)
+                {
+                    ++syscalls;
+                    can_wait = enter(0, IORING_ENTER_GETEVENTS) >= 0 || errno == EINTR;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            for_each_completion(handler);
+        }
+    }
+
+private:
+    static constexpr size_t s_busy_retries{1000};
+
+    [[nodiscard]] bool has_completion() const
+    {
+        return *m_cq_head != __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+    }
+
+    long enter(const unsigned to_submit, const unsigned flags)
+    {
+        if (m_fault_errno != 0 && m_enter_calls++ >= m_fault_after &&
+            (m_fault_count == 0 || m_faults < m_fault_count))
+        {
+            ++m_faults;
+            errno = m_fault_errno;
+            return -1;
+        }
+        return syscall(__NR_io_uring_enter, m_fd, to_submit, 1, flags, nullptr, 0);
+    }
+
+    bool supports_ops() const
+    {
+        constexpr unsigned op_count{64};
+        std::vector<char> buffer(sizeof(io_uring_probe) + op_count * sizeof(io_uring_probe_op), 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+        if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, op_count) < 0)
+        {
+            return false;
+        }
+        for (const unsigned op : {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE})
+        {
+            if (op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void release()
+    {
+        if (m_sqes != nullptr)
+        {
+            munmap(m_sqes, m_sqes_size);
+            m_sqes = nullptr;
+        }
+        if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring)
+        {
+            munmap(m_cq_ring, m_cq_size);
+        }
+        if (m_sq_ring != nullptr)
+        {
+            munmap(m_sq_ring, m_sq_size);
+        }
+        m_sq_ring = m_cq_ring = nullptr;
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    int m_fd{-1};
+
+    void* m_sq_ring{nullptr};
+
+    void* m_cq_ring{nullptr};
+
+    size_t m_sq_size{0};
+
+    size_t m_cq_size{0};
+
+    size_t m_sqes_size{0};
+
+    io_uring_sqe* m_sqes{nullptr};
+
+    unsigned* m_sq_head{nullptr};
+
+    unsigned* m_sq_tail{nullptr};
+
+    unsigned* m_sq_array{nullptr};
+
+    unsigned m_sq_mask{0};
+
+    unsigned m_sq_entries{0};
+
+    unsigned m_local_tail{0};
+
+    unsigned m_pending{0};
+
+    // submitted entries whose completion has not been reaped
+    unsigned m_in_kernel{0};
+
+    int m_fault_errno{0};
+
+    size_t m_fault_after{0};
+
+    size_t m_fault_count{0};
+
+    size_t m_enter_calls{0};
+
+    size_t m_faults{0};
+
+    unsigned* m_cq_head{nullptr};
+
+    unsigned* m_cq_tail{nullptr};
+
+    unsigned m_cq_mask{0};
+
+    io_uring_cqe* m_cqes{nullptr};
+};
+#endif
+
+#if defined (_WIN32) || defined(_WIN64)
+bool read_whole_file(const std::string& path, std::string& out, uint64_t& syscalls)
+{
+    // CreateFile, GetFileSizeEx, ReadFile, CloseHandle under the stream
+    syscalls += 4;
+    return TextFileHelper::read_bytes(path, out);
+}
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+bool read_whole_file(const std::string& path, std::string& out, uint64_t& syscalls)
+{
+    ++syscalls;
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info{};
+    ++syscalls;
+    bool ok = ::fstat(fd, &info) == 0;
+    if (ok)
+    {
+        out.resize(static_cast<size_t>(info.st_size));
+        size_t offset{0};
+        while (offset < out.size())
+        {
+            ++syscalls;
+            const ssize_t n = ::read(fd, out.data() + offset, out.size() - offset);
+            if (n <= 0)
+            {
+                ok = n == 0;
+                break;
+            }
+            offset += static_cast<size_t>(n);
+        }
+        out.resize(offset);
+    }
+    ++syscalls;
+    ::close(fd);
+    return ok;
+}
+#endif
+}
+
+LyricBatchLoader::LyricBatchLoader(const Backend backend
+                                   , const size_t queue_depth
+                                   , const size_t thread_count)
+    : m_backend{backend},
+      m_queue_depth{std::clamp<size_t>(queue_depth, 1, 4096)},
+      m_thread_count{std::max<size_t>(thread_count, 1)}
+{
+    if (m_backend == Backend::Auto)
+    {
+        m_backend = io_uring_available() ? Backend::IoUring : Backend::ThreadPool;
+    }
+    else if (m_backend == Backend::IoUring && !io_uring_available())
+    {
+        std::cerr << "LyricBatchLoader: io_uring unavailable, using the thread pool\n";
+        m_backend = Backend::ThreadPool;
+    }
+}
+
+LyricBatchLoader::~LyricBatchLoader() = default;
+
+void LyricBatchLoader::inject_submit_error(const int error_number
+                                           , const size_t after_calls
+                                           , const size_t count)
+{
+    m_fault_errno = error_number;
+    m_fault_after = after_calls;
+    m_fault_count = count;
+}
+
+bool LyricBatchLoader::io_uring_available()
+{
+#if defined(__linux__) && defined(LYRIC_PARSER_HAS_IO_URING)
+    static const bool available = IoUring{4}.is_open();
+    return available;
+#else
+    return false;
+#endif
+}
+
+LyricLoaderStats LyricBatchLoader::load(const std::vector<std::string>& paths
+                                        , const Sink& sink) const
+{
+    const auto begin = std::chrono::steady_clock::now();
+    LyricLoaderStats stats = m_backend == Backend::IoUring
+                                 ? load_io_uring(paths, sink)
+                                 : load_thread_pool(paths, sink);
+    stats.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+LyricLoaderStats LyricBatchLoader::load_io_uring(const std::vector<std::string>& paths
+                                                 , const Sink& sink) const
+{
+#if defined(__linux__) && defined(LYRIC_PARSER_HAS_IO_URING)
+    enum Op : uint64_t
+    {
+        Open = 0, Stat = 1, Read = 2, Close = 3
+    };
+    struct Slot
+    {
+        LyricLoadedFile m_file;
+
+        struct statx m_statx{};
+
+        int m_fd{-1};
+
+        size_t m_offset{0};
+
+        // completions still expected for the current step
+        int m_waiting{0};
+
+        bool m_failed{false};
+
+        bool m_busy{false};
+    };
+
+    LyricLoaderStats stats;
+    // every slot has at most two operations in flight
+    IoUring ring{static_cast<unsigned>(m_queue_depth * 2)};
+    ++stats.m_syscalls;
+    if (!ring.is_open())
+    {
+        return load_thread_pool(paths, sink);
+    }
+    ring.inject_error(m_fault_errno, m_fault_after, m_fault_count);
+    std::vector<Slot> slots(m_queue_depth);
+    std::vector<size_t> free_slots;
+    for (size_t i = m_queue_depth; i > 0; --i)
+    {
+        free_slots.push_back(i - 1);
+    }
+    const auto push = [&ring](const size_t slot, const Op op) -> io_uring_sqe*
+    {
+        // two entries per slot, the ring cannot be full here
+        io_uring_sqe* sqe = ring.next_sqe();
+        sqe->opcode = static_cast<uint8_t>(op == Open
+                                               ? IORING_OP_OPENAT
+                                               : op == Stat
+                                                     ? IORING_OP_STATX
+                                                     : op == Read
+                                                           ? IORING_OP_READ
+                                                           : IORING_OP_CLOSE);
+        sqe->user_data = static_cast<uint64_t>(slot) << 2 | op;
+        return sqe;
+    };
+    const auto submit_read = [&slots, &push](const size_t index)
+    {
+        Slot& slot = slots[index];
+        io_uring_sqe* sqe = push(index, Read);
+        sqe->fd = slot.m_fd;
+        sqe->addr = reinterpret_cast<uint64_t>(slot.m_file.m_bytes.data() + slot.m_offset);
+        sqe->len = static_cast<uint32_t>(std::min<size_t>(slot.m_file.m_bytes.size() - slot.m_offset
+                                                          , UINT32_MAX));
+        sqe->off = slot.m_offset;
+        slot.m_waiting = 1;
+    };
+    const auto submit_close = [&slots, &push](const size_t index)
+    {
+        Slot& slot = slots[index];
+        io_uring_sqe* sqe = push(index, Close);
+        sqe->fd = slot.m_fd;
+        slot.m_waiting = 1;
+    };
+
+    size_t next_path{0};
+    size_t in_flight{0};
+    while (next_path < paths.size() || in_flight != 0)
+    {
+        // 1. Start files while slots are free, open and statx go out together
+        while (next_path < paths.size() && !free_slots.empty())
+        {
+            const size_t index = free_slots.back();
+            free_slots.pop_back();
+            Slot& slot = slots[index];
+            slot = Slot{};
+            slot.m_busy = true;
+            slot.m_file.m_path = paths[next_path++];
+            io_uring_sqe* open = push(index, Open);
+            open->fd = AT_FDCWD;
+            open->addr = reinterpret_cast<uint64_t>(slot.m_file.m_path.c_str());
+            open->open_flags = O_RDONLY | O_CLOEXEC;
+            io_uring_sqe* stat = push(index, Stat);
+            stat->fd = AT_FDCWD;
+            stat->addr = reinterpret_cast<uint64_t>(slot.m_file.m_path.c_str());
+            stat->len = STATX_SIZE;
+            stat->off = reinterpret_cast<uint64_t>(&slot.m_statx);
+            slot.m_waiting = 2;
+            ++in_flight;
+        }
+        // 1.
+
+        // 2. One system call submits everything queued and waits
+        if (!ring.submit_and_wait(stats.m_syscalls))
+        {
+            break;
+        }
+        // 2.
+
+        // 3. Advance every slot that completed a step
+        ring.for_each_completion([&](const uint64_t user_data, const int32_t res)
+        {
+            const size_t index = static_cast<size_t>(user_data >> 2);
+            const auto op = static_cast<Op>(user_data & 3);
+            Slot& slot = slots[index];
+            --slot.m_waiting;
+            switch (op)
+            {
+                case Open: {
+                    slot.m_fd = res;
+                    slot.m_failed |= res < 0;
+                    break;
+                }
+                case Stat: {
+                    slot.m_failed |= res < 0;
+                    if (res >= 0)
+                    {
+                        slot.m_file.m_bytes.resize(static_cast<size_t>(slot.m_statx.stx_size));
+                    }
+                    break;
+                }
+                case Read: {
+                    if (res <= 0)
+                    {
+                        slot.m_failed |= res < 0;
+                        slot.m_file.m_bytes.resize(slot.m_offset);
+                    }
+                    else
+                    {
+                        slot.m_offset += static_cast<size_t>(res);
+                        if (slot.m_offset < slot.m_file.m_bytes.size())
+                        {
+                            submit_read(index);
+                            return;
+                        }
+                    }
+                    submit_close(index);
+                    return;
+                }
+                case Close: {
+                    slot.m_fd = -1;
+                    break;
+                }
+            }
+            if (slot.m_waiting != 0)
+            {
+                return;
+            }
+            if ((op == Open || op == Stat) && slot.m_fd >= 0)
+            {
+                if (!slot.m_failed && !slot.m_file.m_bytes.empty())
+                {
+                    submit_read(index);
+                }
+                else
+                {
+                    submit_close(index);
+                }
+                return;
+            }
+            // closed, or the open itself failed
+            slot.m_file.m_ok = !slot.m_failed;
+            if (slot.m_file.m_ok)
+            {
+                ++stats.m_files;
+                stats.m_bytes += slot.m_file.m_bytes.size();
+            }
+            else
+            {
+                ++stats.m_failed;
+                slot.m_file.m_bytes.clear();
+            }
+            sink(std::move(slot.m_file));
+            slot.m_busy = false;
+            free_slots.push_back(index);
+            --in_flight;
+        });
+        // 3.
+    }
+
+    // 4. After a ring failure, settle what the kernel still holds before the
+    //    slots go away, deliver the files in flight as failed and read the
+    //    files never started on the thread pool
+    if (in_flight != 0)
+    {
+        ring.drain([&slots](const uint64_t user_data, const int32_t res)
+                   {
+                       Slot& slot = slots[static_cast<size_t>(user_data >> 2)];
+                       const auto op = static_cast<Op>(user_data & 3);
+                       if (op == Open && res >= 0)
+                       {
+                           slot.m_fd = res;
+                       }
+                       else if (op == Close)
+                       {
+                           slot.m_fd = -1;
+                       }
+                   }
+                   , stats.m_syscalls);
+        for (auto& slot : slots)
+        {
+            if (!slot.m_busy)
+            {
+                continue;
+            }
+            if (slot.m_fd >= 0)
+            {
+                ++stats.m_syscalls;
+                ::close(slot.m_fd);
+            }
+            slot.m_file.m_ok = false;
+            slot.m_file.m_bytes.clear();
+            ++stats.m_failed;
+            sink(std::move(slot.m_file));
+            slot.m_busy = false;
+        }
+    }
+    if (next_path < paths.size())
+    {
+        const std::vector<std::string> rest(paths.begin() + static_cast<std::ptrdiff_t>(next_path)
+                                            , paths.end());
+        const LyricLoaderStats fallback = load_thread_pool(rest, sink);
+        stats.m_files += fallback.m_files;
+        stats.m_failed += fallback.m_failed;
+        stats.m_bytes += fallback.m_bytes;
+        stats.m_syscalls += fallback.m_syscalls;
+    }
+    // 4.
+    return stats;
+#else
+    return load_thread_pool(paths, sink);
+#endif
+}
+
+LyricLoaderStats LyricBatchLoader::load_thread_pool(const std::vector<std::string>& paths
+                                                    , const Sink& sink) const
+{
+    std::atomic<size_t> next_path{0};
+    std::atomic<uint64_t> files{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> syscalls{0};
+    const auto work = [&]()
+    {
+        uint64_t local_syscalls{0};
+        for (size_t i = next_path++; i < paths.size(); i = next_path++)
+        {
+            LyricLoadedFile file;
+            file.m_path = paths[i];
+            file.m_ok = read_whole_file(file.m_path, file.m_bytes, local_syscalls);
+            if (file.m_ok)
+            {
+                ++files;
+                bytes += file.m_bytes.size();
+            }
+            else
+            {
+                ++failed;
+                file.m_bytes.clear();
+            }
+            sink(std::move(file));
+        }
+        syscalls += local_syscalls;
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::min(m_thread_count, paths.size()); ++i)
+    {
+        threads.emplace_back(work);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    LyricLoaderStats stats;
+    stats.m_files = files;
+    stats.m_failed = failed;
+    stats.m_bytes = bytes;
+    stats.m_syscalls = syscalls;
+    return stats;
+}
+}
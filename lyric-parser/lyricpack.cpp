@@ -0,0 +1,416 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricpack.h>
+#include "binaryio.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace AudioToolKits
+{
+namespace
+{
+constexpr size_t s_align{8};
+
+std::string build_header(const uint32_t entry_count
+                         , const uint32_t bucket_count
+                         , const uint32_t key_pool_size
+                         , const uint64_t directory_offset
+                         , const uint64_t dead_bytes
+                         , const uint64_t total_size)
+{
+    using namespace BinaryIO;
+    std::string header(LyricPack::s_header_size, '\0');
+    std::memcpy(header.data(), LyricPack::s_magic, sizeof(LyricPack::s_magic));
+    patch_u16(header, LyricPack::Version, LyricPack::s_version);
+    patch_u32(header, LyricPack::HeaderSize, LyricPack::s_header_size);
+    patch_u32(header, LyricPack::EntryCount, entry_count);
+    patch_u32(header, LyricPack::BucketCount, bucket_count);
+    patch_u32(header, LyricPack::KeyPoolSize, key_pool_size);
+    patch_u64(header, LyricPack::DirectoryOffset, directory_offset);
+    patch_u64(header, LyricPack::DeadBytes, dead_bytes);
+    patch_u64(header, LyricPack::TotalSize, total_size);
+    return header;
+}
+
+// validates the header and returns the directory, nullptr if the pack is unusable
+const char* directory_of(const char* data, const size_t size)
+{
+    using namespace BinaryIO;
+    if (data == nullptr || size < LyricPack::s_header_size ||
+        std::memcmp(data, LyricPack::s_magic, sizeof(LyricPack::s_magic)) != 0)
+    {
+        std::cerr << "LyricPack: not a lyric pack" << std::endl;
+        return nullptr;
+    }
+    if (load_u16(data + LyricPack::Version) != LyricPack::s_version)
+    {
+        std::cerr << "LyricPack: unsupported version " <<
+                load_u16(data + LyricPack::Version) << std::endl;
+        return nullptr;
+    }
+    const uint64_t directory_offset = load_u64(data + LyricPack::DirectoryOffset);
+    const uint64_t directory_size =
+            uint64_t{load_u32(data + LyricPack::BucketCount)} * LyricPack::s_bucket_size +
+            load_u32(data + LyricPack::KeyPoolSize);
+    const uint32_t bucket_count = load_u32(data + LyricPack::BucketCount);
+    if (load_u64(data + LyricPack::TotalSize) > size ||
+        directory_offset + directory_size > size ||
+        bucket_count == 0 || (bucket_count & (bucket_count - 1)) != 0)
+    {
+        std::cerr << "LyricPack: truncated or corrupt directory" << std::endl;
+        return nullptr;
+    }
+    return data + directory_offset;
+}
+}
+
+std::string LyricPack::path_key(const std::string_view file_path)
+{
+    return "path:" + std::filesystem::path{file_path}.lexically_normal().generic_string();
+}
+
+std::string LyricPack::song_id_key(const uint64_t song_id)
+{
+    return "id:" + std::to_string(song_id);
+}
+
+std::string LyricPack::artist_title_key(const std::string_view artist
+                                        , const std::string_view title)
+{
+    std::string key{"at:"};
+    key.append(artist);
+    // unit separator, cannot appear in a tag value
+    key.push_back('\x1f');
+    key.append(title);
+    return key;
+}
+
+LyricPackBuilder::LyricPackBuilder(const std::string_view pack_path)
+    : m_pack_path{pack_path}
+{
+    m_is_valid = load_existing();
+}
+
+LyricPackBuilder::~LyricPackBuilder() = default;
+
+void LyricPackBuilder::add(const std::string_view key, const LyricParser& parser)
+{
+    Entry& entry = m_entries[std::string{key}];
+    if (entry.m_pending.empty())
+    {
+        // an entry already written to the pack is superseded
+        m_dead_bytes += entry.m_size;
+    }
+    entry.m_pending = LyricCompiler::compile(parser);
+    entry.m_size = static_cast<uint32_t>(entry.m_pending.size());
+    entry.m_offset = 0;
+}
+
+void LyricPackBuilder::add_file(const std::string_view lrc_path)
+{
+    const LyricParser parser{lrc_path};
+    add(LyricPack::path_key(lrc_path), parser);
+}
+
+bool LyricPackBuilder::remove(const std::string_view key)
+{
+    const auto it = m_entries.find(std::string{key});
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+    if (it->second.m_pending.empty())
+    {
+        m_dead_bytes += it->second.m_size;
+    }
+    m_entries.erase(it);
+    return true;
+}
+
+bool LyricPackBuilder::commit()
+{
+    using namespace BinaryIO;
+    if (!m_is_valid)
+    {
+        // a corrupt pack or some other file, truncating it would destroy it
+        std::cerr << "LyricPackBuilder::commit: " << m_pack_path <<
+                " is not a lyric pack, refusing to overwrite it" << std::endl;
+        return false;
+    }
+    const bool is_new = m_file_size == 0;
+    if (is_new)
+    {
+        std::ofstream create(m_pack_path, std::ios::binary | std::ios::trunc);
+        create << build_header(0, 0, 0, 0, 0, 0);
+        if (!create)
+        {
+            std::cerr << "LyricPackBuilder::commit: failed to create " <<
+                    m_pack_path << std::endl;
+            return false;
+        }
+        m_file_size = LyricPack::s_header_size;
+    }
+
+    std::fstream pack(m_pack_path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!pack.is_open())
+    {
+        std::cerr << "LyricPackBuilder::commit: failed to open " << m_pack_path <<
+                std::endl;
+        return false;
+    }
+
+    // 1. Append pending blobs after everything already in the pack
+    std::string tail;
+    const auto position = [this, &tail]()
+    {
+        return m_file_size + tail.size();
+    };
+    for (auto& [key, entry] : m_entries)
+    {
+        if (entry.m_pending.empty())
+        {
+            continue;
+        }
+        while (position() % s_align != 0)
+        {
+            tail.push_back('\0');
+        }
+        entry.m_offset = position();
+        tail.append(entry.m_pending);
+        entry.m_pending.clear();
+        entry.m_pending.shrink_to_fit();
+    }
+    // 1.
+
+    // 2. New directory, the previous one becomes dead space
+    while (position() % s_align != 0)
+    {
+        tail.push_back('\0');
+    }
+    const uint64_t directory_offset = position();
+    if (!is_new)
+    {
+        m_dead_bytes += m_directory_bytes;
+    }
+    uint32_t bucket_count{0};
+    uint32_t key_pool_size{0};
+    tail.append(build_directory(m_entries, bucket_count, key_pool_size));
+    const uint64_t total_size = position();
+    // 2.
+
+    // 3. Write data first and the header last
+    pack.seekp(static_cast<std::streamoff>(m_file_size));
+    pack.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    pack.flush();
+    const std::string header = build_header(static_cast<uint32_t>(m_entries.size())
+                                            , bucket_count
+                                            , key_pool_size
+                                            , directory_offset
+                                            , m_dead_bytes
+                                            , total_size);
+    pack.seekp(0);
+    pack.write(header.data(), static_cast<std::streamsize>(header.size()));
+    pack.flush();
+    if (!pack)
+    {
+        std::cerr << "LyricPackBuilder::commit: write failed" << std::endl;
+        return false;
+    }
+    pack.close();
+    // 3.
+
+    std::error_code ec;
+    if (std::filesystem::file_size(m_pack_path, ec) > total_size)
+    {
+        std::filesystem::resize_file(m_pack_path, total_size, ec);
+    }
+    m_directory_bytes = total_size - directory_offset;
+    m_file_size = total_size;
+    return true;
+}
+
+bool LyricPackBuilder::compact(const std::string_view pack_path)
+{
+    const LyricPackBuilder source{pack_path};
+    if (!source.m_is_valid)
+    {
+        std::cerr << "LyricPackBuilder::compact: " << pack_path <<
+                " is not a lyric pack" << std::endl;
+        return false;
+    }
+    if (source.m_file_size == 0)
+    {
+        return false;
+    }
+
+    const std::string temp_path = std::string{pack_path} + ".compact";
+    std::error_code ec;
+    std::filesystem::remove(temp_path, ec);
+    {
+        // the source mapping must be released before the rename on Windows
+        const MappedFile mapped{pack_path};
+        if (!mapped.is_open())
+        {
+            return false;
+        }
+        LyricPackBuilder target{temp_path};
+        for (const auto& [key, entry] : source.m_entries)
+        {
+            if (entry.m_offset + entry.m_size > mapped.size())
+            {
+                continue;
+            }
+            Entry& copy = target.m_entries[key];
+            copy.m_pending.assign(mapped.data() + entry.m_offset, entry.m_size);
+            copy.m_size = entry.m_size;
+        }
+        if (!target.commit())
+        {
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, std::string{pack_path}, ec);
+    if (ec)
+    {
+        std::cerr << "LyricPackBuilder::compact: rename failed: " << ec.message() <<
+                std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LyricPackBuilder::load_existing()
+{
+    using namespace BinaryIO;
+    std::error_code ec;
+    if (!std::filesystem::exists(m_pack_path, ec) ||
+        std::filesystem::file_size(m_pack_path, ec) == 0)
+    {
+        // nothing to lose, commit() creates the pack
+        return true;
+    }
+    const MappedFile mapped{m_pack_path};
+    const char* directory = directory_of(mapped.data(), mapped.size());
+    if (directory == nullptr)
+    {
+        return false;
+    }
+    const char* data = mapped.data();
+    const uint32_t bucket_count = load_u32(data + LyricPack::BucketCount);
+    const char* keys = directory + uint64_t{bucket_count} * LyricPack::s_bucket_size;
+    for (uint32_t i = 0; i < bucket_count; ++i)
+    {
+        const char* bucket = directory + uint64_t{i} * LyricPack::s_bucket_size;
+        if (load_u32(bucket + LyricPack::Used) == 0)
+        {
+            continue;
+        }
+        Entry entry;
+        entry.m_offset = load_u64(bucket + LyricPack::BlobOffset);
+        entry.m_size = load_u32(bucket + LyricPack::BlobSize);
+        m_entries.emplace(std::string{keys + load_u32(bucket + LyricPack::KeyOffset), load_u32(bucket + LyricPack::KeyLength)}
+                          , std::move(entry));
+    }
+    m_file_size = load_u64(data + LyricPack::TotalSize);
+    m_dead_bytes = load_u64(data + LyricPack::DeadBytes);
+    m_directory_bytes = uint64_t{bucket_count} * LyricPack::s_bucket_size +
+                        load_u32(data + LyricPack::KeyPoolSize);
+    return true;
+}
+
+std::string LyricPackBuilder::build_directory(
+    const std::map<std::string, Entry>& entries
+    , uint32_t& bucket_count
+    , uint32_t& key_pool_size)
+{
+    using namespace BinaryIO;
+    // load factor at most one half keeps probe sequences short
+    bucket_count = 8;
+    while (bucket_count < entries.size() * 2)
+    {
+        bucket_count <<= 1;
+    }
+
+    std::string table(uint64_t{bucket_count} * LyricPack::s_bucket_size, '\0');
+    std::string keys;
+    for (const auto& [key, entry] : entries)
+    {
+        const uint64_t hash = fnv1a(key);
+        uint32_t slot = static_cast<uint32_t>(hash) & (bucket_count - 1);
+        while (load_u32(table.data() + uint64_t{slot} * LyricPack::s_bucket_size + LyricPack::Used) != 0)
+        {
+            slot = (slot + 1) & (bucket_count - 1);
+        }
+        const size_t bucket = uint64_t{slot} * LyricPack::s_bucket_size;
+        patch_u64(table, bucket + LyricPack::KeyHash, hash);
+        patch_u64(table, bucket + LyricPack::BlobOffset, entry.m_offset);
+        patch_u32(table, bucket + LyricPack::BlobSize, entry.m_size);
+        patch_u32(table, bucket + LyricPack::KeyOffset, static_cast<uint32_t>(keys.size()));
+        patch_u32(table, bucket + LyricPack::KeyLength, static_cast<uint32_t>(key.size()));
+        patch_u32(table, bucket + LyricPack::Used, 1);
+        keys.append(key);
+    }
+    key_pool_size = static_cast<uint32_t>(keys.size());
+    table.append(keys);
+    return table;
+}
+
+LyricPackReader::LyricPackReader(const std::string_view pack_path)
+    : m_file{pack_path}
+{
+    using namespace BinaryIO;
+    m_directory = directory_of(m_file.data(), m_file.size());
+    if (m_directory == nullptr)
+    {
+        return;
+    }
+    m_entry_count = load_u32(m_file.data() + LyricPack::EntryCount);
+    m_bucket_count = load_u32(m_file.data() + LyricPack::BucketCount);
+    m_key_pool_size = load_u32(m_file.data() + LyricPack::KeyPoolSize);
+    m_dead_bytes = load_u64(m_file.data() + LyricPack::DeadBytes);
+    m_keys = m_directory + uint64_t{m_bucket_count} * LyricPack::s_bucket_size;
+}
+
+std::optional<LyricBinaryView> LyricPackReader::find(const std::string_view key) const
+{
+    using namespace BinaryIO;
+    if (m_directory == nullptr)
+    {
+        return std::nullopt;
+    }
+    const uint64_t hash = fnv1a(key);
+    uint32_t slot = static_cast<uint32_t>(hash) & (m_bucket_count - 1);
+    for (uint32_t probe = 0; probe < m_bucket_count; ++probe)
+    {
+        const char* bucket = m_directory + uint64_t{slot} * LyricPack::s_bucket_size;
+        if (load_u32(bucket + LyricPack::Used) == 0)
+        {
+            break;
+        }
+        const uint32_t key_offset = load_u32(bucket + LyricPack::KeyOffset);
+        const uint32_t key_length = load_u32(bucket + LyricPack::KeyLength);
+        if (load_u64(bucket + LyricPack::KeyHash) == hash &&
+            uint64_t{key_offset} + key_length <= m_key_pool_size &&
+            std::string_view{m_keys + key_offset, key_length} == key)
+        {
+            const uint64_t offset = load_u64(bucket + LyricPack::BlobOffset);
+            const uint32_t size = load_u32(bucket + LyricPack::BlobSize);
+            if (offset + size > m_file.size())
+            {
+                return std::nullopt;
+            }
+            LyricBinaryView view{m_file.data() + offset, size};
+            if (!view.is_valid())
+            {
+                return std::nullopt;
+            }
+            return view;
+        }
+        slot = (slot + 1) & (m_bucket_count - 1);
+    }
+    return std::nullopt;
+}
+}
@@ -0,0 +1,41 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricparsecore.h>
+#include <charconv>
+
+namespace AudioToolKits
+{
+namespace
+{
+// fields are validated by the scanner, all digits
+int64_t to_int(const std::string_view digits)
+{
+    int64_t value{0};
+    std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    return value;
+}
+}
+
+int64_t LyricSyntax::time_to_ms(const std::string_view time_str)
+{
+    return match_time(time_str).value_or(0);
+}
+
+int64_t LyricSyntax::time_to_ms(const std::string_view min
+                                , const std::string_view sec
+                                , const std::string_view ms)
+{
+    // hundredths or milliseconds, as scan_time()
+    const int64_t fraction = ms.size() == 2 ? to_int(ms) * 10 : to_int(ms);
+    return (to_int(min) * 60 + to_int(sec)) * 1000 + fraction;
+}
+
+int64_t LyricSyntax::time_to_ms(const std::string_view hour
+                                , const std::string_view min
+                                , const std::string_view sec
+                                , const std::string_view ms)
+{
+    return to_int(hour) * 3600000 + time_to_ms(min, sec, ms);
+}
+}
@@ -2,12 +2,108 @@
 // Created by 31305 on 25-6-18.
 //
 #include <lyricparser.h>
+#include <algorithm>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <thread>
 #include "textfilehelper.h"
 
 namespace AudioToolKits
 {
-LyricParser::LyricParser(const std::string_view file_path)
+namespace
+{
+// forwards to a visitor, adding the diagnostics of a streamed parse
+class LyricDiagnosticSink
+{
+public:
+    explicit LyricDiagnosticSink(LyricVisitor& visitor)
+        : m_visitor{visitor}
+    {
+    }
+
+    void on_tag(const std::string_view key)
+    {
+        m_visitor.on_tag(key);
+        ++m_line;
+    }
+
+    void on_line_begin(const int64_t start_ms)
+    {
+        if (start_ms < m_last_start_ms)
+        {
+            m_visitor.on_diagnostic({LyricDiagnostic::Kind::OutOfOrder, m_line, m_current});
+        }
+        m_last_start_ms = start_ms;
+        m_visitor.on_line_begin(start_ms);
+    }
+
+    void on_word(const int64_t start_ms, const uint32_t offset, const std::string_view text)
+    {
+        m_visitor.on_word(start_ms, offset, text);
+    }
+
+    void on_line_end(const int64_t start_ms, const std::string_view text)
+    {
+        m_visitor.on_line_end(start_ms, text);
+        ++m_line;
+    }
+
+    // the raw input line of the next event
+    void set_current(const std::string_view line)
+    {
+        m_current = line;
+    }
+
+    [[nodiscard]] size_t line() const
+    {
+        return m_line;
+    }
+
+private:
+    LyricVisitor& m_visitor;
+
+    std::string_view m_current;
+
+    size_t m_line{0};
+
+    int64_t m_last_start_ms{INT64_MIN};
+};
+
+template <typename Iterator>
+void visit_content(Iterator o_it, const Iterator end, LyricVisitor& visitor)
+{
+    if (o_it == end)
+    {
+        visitor.on_diagnostic({LyricDiagnostic::Kind::EmptyInput, 0, {}});
+        return;
+    }
+    LyricParser::ParseCore core;
+    LyricDiagnosticSink sink{visitor};
+    o_it = core.parse_tags(o_it, end, sink);
+    // one line at a time, so an out-of-order diagnostic can name its line
+    for (; o_it != end; ++o_it)
+    {
+        sink.set_current(std::string_view{*o_it});
+        if (core.parse_text(o_it, std::next(o_it), sink) == o_it)
+        {
+            visitor.on_diagnostic({LyricDiagnostic::Kind::Stopped, sink.line(), std::string_view{*o_it}});
+            return;
+        }
+    }
+}
+}
+
+LyricParser::LyricParser(std::pmr::memory_resource* resource)
+    : m_resource{resource},
+      m_lyric_vector{resource}
+{
+}
+
+LyricParser::LyricParser(const std::string_view file_path
+                         , std::pmr::memory_resource* resource)
+    : m_resource{resource},
+      m_lyric_vector{resource}
 {
     reload_file(file_path);
 }
@@ -15,6 +111,12 @@ LyricParser::LyricParser(const std::string_view file_path)
 LyricParser::~LyricParser() = default;
 
 void LyricParser::parse_lrc(const std::vector<std::string>& file_content)
+{
+    parse_content(file_content);
+}
+
+template <typename Content>
+void LyricParser::parse_content(const Content& file_content)
 {
     if (file_content.empty())
     {
@@ -23,85 +125,180 @@ void LyricParser::parse_lrc(const std::vector<std::string>& file_content)
         return;
     }
 
-    std::smatch results_match;
-    auto o_it = file_content.begin();
-
     // 1. Tags match
-    while (o_it != file_content.end() && std::regex_match(*o_it
-        , results_match
-        , s_regex_match_tag))
+    auto o_it = parse_tags(file_content.begin(), file_content.end());
+    // 1.
+
+    // 2. Text match, chunked over several threads for large inputs
+    size_t threads = m_parallel_threads != 0
+                         ? m_parallel_threads
+                         : std::thread::hardware_concurrency();
+    threads = std::min(threads, static_cast<size_t>(file_content.end() - o_it));
+    size_t bytes{0};
+    for (auto it = o_it; threads > 1 && it != file_content.end() && bytes < m_parallel_threshold; ++it)
     {
-        m_lyric_vector.emplace_back(results_match[1].str());
-        ++o_it;
+        bytes += it->size();
     }
-    // 1.
+    if (threads > 1 && bytes >= m_parallel_threshold)
+    {
+        parse_text_parallel(o_it, file_content.end(), threads);
+    }
+    else
+    {
+        parse_text(o_it, file_content.end());
+    }
+    // 2.
 
-    // 2. Text match
-    while (o_it != file_content.end() && std::regex_match(*o_it
-        , results_match
-        , s_regex_match_text))
-    {
-        int64_t start_ms = time_to_ms(results_match[1].str()
-                                           , results_match[2].str()
-                                           , results_match[3].str());
-        std::string text = results_match[5].str();
-        TextFileHelper::trim_string(text);
-        std::string result;
-        if (m_is_enhanced ==
-            EnhancedState::Uninitialized)
-        {
-            if (std::regex_search(text
-                                  , results_match
-                                  , s_regex_search_enhanced_text))
-            {
-                m_is_enhanced = EnhancedState::True;
-            }
-            else
-            {
-                m_is_enhanced = EnhancedState::False;
-            }
-        }
-        if (m_is_enhanced == EnhancedState::True)
+    // 3. Time order and end times
+    sort_text_lines();
+    compute_end_times();
+    // 3.
+}
+
+template <typename Iterator>
+Iterator LyricParser::parse_tags(const Iterator o_it, const Iterator end)
+{
+    LyricBasicLineCollector collector{m_lyric_vector, m_word_vector};
+    return ParseCore{}.parse_tags(o_it, end, collector);
+}
+
+template <typename Iterator>
+Iterator LyricParser::parse_text(Iterator o_it, const Iterator end)
+{
+    ParseCore core{m_is_enhanced == EnhancedState::Uninitialized
+                       ? std::nullopt
+                       : std::optional<bool>{m_is_enhanced == EnhancedState::True}};
+    // words index get_text(), continue after the lines already parsed
+    LyricBasicLineCollector collector{m_lyric_vector
+                                      , m_word_vector
+                                      , static_cast<uint32_t>(m_lyric_vector.size() - tag_count())};
+    o_it = core.parse_text(o_it, end, collector);
+    if (const auto enhanced = core.enhanced())
+    {
+        m_is_enhanced = *enhanced ? EnhancedState::True : EnhancedState::False;
+    }
+    return o_it;
+}
+
+template <typename Iterator>
+void LyricParser::parse_text_parallel(Iterator o_it, const Iterator end, const size_t threads)
+{
+    // 1. The first text line fixes the format for every chunk, as in the serial parse
+    if (m_is_enhanced == EnhancedState::Uninitialized)
+    {
+        const auto first = o_it;
+        o_it = parse_text(o_it, std::next(o_it));
+        if (o_it == first)
         {
-            while (std::regex_search(text
-                                     , results_match
-                                     , s_regex_search_enhanced_text))
-            {
-                std::string match_word = results_match[2].str();
-                TextFileHelper::trim_string(match_word);
-                if (TextFileHelper::is_English(match_word))
-                {
-                    match_word += ' ';
-                }
-                result.append(match_word);
-                text = results_match.suffix();
-            }
-            if (std::isspace(static_cast<unsigned char>(result.back())))
-            {
-                result.pop_back();
-            }
+            return;
         }
-        else if (m_is_enhanced == EnhancedState::False)
+    }
+    // 1.
+
+    // 2. Chunks of whole lines, parsed into private results on the default
+    // resource, a caller supplied arena need not be thread-safe
+    const auto line_count = static_cast<size_t>(end - o_it);
+    const size_t chunk_lines = (line_count + threads - 1) / threads;
+    std::vector<LyricParser> chunks(threads);
+    std::vector<std::future<void>> pending;
+    for (size_t chunk = 1; chunk < threads; ++chunk)
+    {
+        const auto begin = o_it + static_cast<std::ptrdiff_t>(std::min(line_count, chunk * chunk_lines));
+        const auto chunk_end = o_it + static_cast<std::ptrdiff_t>(std::min(line_count, (chunk + 1) * chunk_lines));
+        chunks[chunk].m_is_enhanced = m_is_enhanced;
+        pending.push_back(std::async(std::launch::async
+                                     , [&chunks, chunk, begin, chunk_end]()
+                                     {
+                                         chunks[chunk].parse_text(begin, chunk_end);
+                                     }));
+    }
+    const auto first_end = o_it + static_cast<std::ptrdiff_t>(std::min(line_count, chunk_lines));
+    const bool first_complete = parse_text(o_it, first_end) == first_end;
+    for (auto& future : pending)
+    {
+        future.get();
+    }
+    // 2.
+
+    // 3. Merge in order, the serial parse stops at the first line that is not
+    // a text line, so does the merge
+    if (!first_complete)
+    {
+        return;
+    }
+    for (size_t chunk = 1; chunk < threads; ++chunk)
+    {
+        append_lines(chunks[chunk]);
+        const size_t expected = std::min(line_count, (chunk + 1) * chunk_lines) -
+                                std::min(line_count, chunk * chunk_lines);
+        if (chunks[chunk].line_count() != expected)
         {
-            result = text;
+            break;
         }
-        m_lyric_vector.emplace_back(start_ms, std::move(result));
-        ++o_it;
     }
-    // 2.
+    // 3.
+}
+
+void LyricParser::parse_buffer(const std::string_view utf8_bytes)
+{
+    parse_content(TextFileHelper::split_lines(utf8_bytes));
+}
+
+void LyricParser::visit_lrc(const std::vector<std::string>& file_content
+                            , LyricVisitor& visitor)
+{
+    visit_content(file_content.begin(), file_content.end(), visitor);
+}
+
+void LyricParser::visit_buffer(const std::string_view utf8_bytes, LyricVisitor& visitor)
+{
+    const LyricBufferLines lines{utf8_bytes};
+    visit_content(lines.begin(), lines.end(), visitor);
+}
+
+bool LyricParser::visit_file(const std::string_view file_path, LyricVisitor& visitor)
+{
+    std::string bytes;
+    if (!TextFileHelper::read_bytes(std::filesystem::path{file_path}, bytes))
+    {
+        return false;
+    }
+    if (!TextFileHelper::is_utf8(bytes))
+    {
+        bytes = TextFileHelper::convert_encoding(bytes, Encoding::GBK, Encoding::UTF8);
+    }
+    const LyricBufferLines lines{bytes};
+    visit_content(lines.begin(), lines.end(), visitor);
+    return lines.begin() != lines.end();
+}
+
+void LyricParser::set_parallel_parse(const size_t threshold_bytes, const size_t max_threads)
+{
+    m_parallel_threshold = threshold_bytes;
+    m_parallel_threads = max_threads;
+}
+
+size_t LyricParser::parallel_threshold() const
+{
+    return m_parallel_threshold;
 }
 
 void LyricParser::reload_file(const std::string_view file_path)
 {
     clear_result();
-    const TextFileHelper text_file{file_path};
-    const auto content = text_file.get_content();
-    parse_lrc(text_file.get_content());
+    const TextFileHelper text_file{file_path, m_resource};
+    parse_content(text_file.content());
 }
 
 std::vector<LyricLine> LyricParser::get_lrc() const
 {
-    return m_lyric_vector;
+    std::vector<LyricLine> lines;
+    lines.reserve(m_lyric_vector.size());
+    for (const auto& line : m_lyric_vector)
+    {
+        lines.push_back(line.to_line());
+    }
+    return lines;
 }
 
 std::vector<std::string> LyricParser::get_tags() const{
@@ -110,7 +307,7 @@ std::vector<std::string> LyricParser::get_tags() const{
     {
         if (line.isTag())
         {
-            tags.emplace_back(line.m_text);
+            tags.emplace_back(line.m_text.data(), line.m_text.size());
         }
         else{
             break;
@@ -128,30 +325,74 @@ std::vector<LyricLine> LyricParser::get_text() const{
     }
     for (; it != m_lyric_vector.end(); ++it)
     {
-        text.emplace_back(*it);
+        text.push_back(it->to_line());
     }
     return text;
 }
 
+const std::vector<LyricWord>& LyricParser::get_words() const
+{
+    return m_word_vector;
+}
+
+const std::vector<int64_t>& LyricParser::get_end_ms() const
+{
+    return m_end_vector;
+}
+
+void LyricParser::set_max_line_duration_ms(const std::optional<int64_t> max_duration_ms)
+{
+    m_max_line_duration_ms = max_duration_ms;
+    compute_end_times();
+}
+
+std::optional<int64_t> LyricParser::max_line_duration_ms() const
+{
+    return m_max_line_duration_ms;
+}
+
+std::optional<int64_t> LyricParser::length_ms() const
+{
+    for (size_t i = 0; i < tag_count(); ++i)
+    {
+        const std::string_view tag{m_lyric_vector[i].m_text};
+        if (LyricSyntax::is_length_tag(tag))
+        {
+            return LyricSyntax::length_ms(tag);
+        }
+    }
+    return std::nullopt;
+}
+
 bool LyricParser::is_enhanced() const
 {
     return m_is_enhanced == EnhancedState::True;
 }
 
-int64_t LyricParser::time_to_ms(
-    const std::string_view time_str)
+size_t LyricParser::memory_usage() const
 {
-    const std::string str{time_str};
-    int64_t result{0};
-    if (std::smatch time_match; std::regex_match(str
-                                                 , time_match
-                                                 , s_regex_match_time))
+    size_t bytes = sizeof(LyricParser) +
+                   m_lyric_vector.capacity() * sizeof(LyricArenaLine) +
+                   m_word_vector.capacity() * sizeof(LyricWord) +
+                   m_end_vector.capacity() * sizeof(int64_t);
+    for (const auto& line : m_lyric_vector)
     {
-        result = time_to_ms(time_match[1].str()
-                            , time_match[2].str()
-                            , time_match[3].str());
+        const auto* object_begin = reinterpret_cast<const char*>(&line.m_text);
+        const auto* object_end = object_begin + sizeof(line.m_text);
+        const bool is_sso = line.m_text.data() >= object_begin &&
+                            line.m_text.data() < object_end;
+        if (!is_sso)
+        {
+            bytes += line.m_text.capacity() + 1;
+        }
     }
-    return result;
+    return bytes;
+}
+
+int64_t LyricParser::time_to_ms(
+    const std::string_view time_str)
+{
+    return LyricSyntax::time_to_ms(time_str);
 }
 
 int64_t LyricParser::time_to_ms(
@@ -159,20 +400,186 @@ int64_t LyricParser::time_to_ms(
     , const std::string_view sec
     , const std::string_view ms)
 {
-    const int64_t time_min{std::stoi(std::string{min})};
-    const int64_t time_sec{std::stoi(std::string{sec})};
-    const int64_t time_ms{std::stoi(std::string{ms})};
-    return (time_min * 60 + time_sec) * 1000 + time_ms;
+    return LyricSyntax::time_to_ms(min, sec, ms);
+}
+
+int64_t LyricParser::time_to_ms(
+    const std::string_view hour
+    , const std::string_view min
+    , const std::string_view sec
+    , const std::string_view ms)
+{
+    return LyricSyntax::time_to_ms(hour, min, sec, ms);
+}
+
+size_t LyricParser::tag_count() const
+{
+    return static_cast<size_t>(std::find_if(m_lyric_vector.begin()
+                                            , m_lyric_vector.end()
+                                            , [](const LyricArenaLine& line)
+                                            {
+                                                return line.isText();
+                                            }) - m_lyric_vector.begin());
+}
+
+void LyricParser::sort_text_lines()
+{
+    const auto text_begin = m_lyric_vector.begin() +
+                            static_cast<std::ptrdiff_t>(tag_count());
+    const auto by_start = [](const LyricArenaLine& a, const LyricArenaLine& b)
+    {
+        return a.start_ms() < b.start_ms();
+    };
+    if (std::is_sorted(text_begin, m_lyric_vector.end(), by_start))
+    {
+        return;
+    }
+
+    // stable order of the text lines, words follow their line
+    const size_t text_count = static_cast<size_t>(m_lyric_vector.end() - text_begin);
+    std::vector<uint32_t> order(text_count);
+    for (uint32_t i = 0; i < text_count; ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin()
+                     , order.end()
+                     , [&text_begin](const uint32_t a, const uint32_t b)
+                     {
+                         return text_begin[a].start_ms() < text_begin[b].start_ms();
+                     });
+    std::vector<uint32_t> new_index(text_count);
+    std::pmr::vector<LyricArenaLine> sorted{m_resource};
+    sorted.reserve(text_count);
+    for (uint32_t i = 0; i < text_count; ++i)
+    {
+        new_index[order[i]] = i;
+        sorted.emplace_back(std::move(text_begin[order[i]]));
+    }
+    std::move(sorted.begin(), sorted.end(), text_begin);
+
+    for (auto& word : m_word_vector)
+    {
+        word.m_line = new_index[word.m_line];
+    }
+    std::stable_sort(m_word_vector.begin()
+                     , m_word_vector.end()
+                     , [](const LyricWord& a, const LyricWord& b)
+                     {
+                         return a.m_line < b.m_line;
+                     });
+}
+
+void LyricParser::compute_end_times()
+{
+    const size_t text_begin = tag_count();
+    const size_t text_count = m_lyric_vector.size() - text_begin;
+    m_end_vector.clear();
+    m_end_vector.reserve(text_count);
+    for (size_t i = 0; i < text_count; ++i)
+    {
+        const int64_t start_ms = m_lyric_vector[text_begin + i].start_ms();
+        int64_t end_ms{0};
+        if (i + 1 < text_count)
+        {
+            end_ms = m_lyric_vector[text_begin + i + 1].start_ms();
+        }
+        else if (const auto length = length_ms(); length && *length > start_ms)
+        {
+            end_ms = *length;
+        }
+        else
+        {
+            // words of the last line are at the back after sorting
+            const int64_t last_start = !m_word_vector.empty() &&
+                                       m_word_vector.back().m_line == i
+                                           ? std::max(start_ms, m_word_vector.back().m_start_ms)
+                                           : start_ms;
+            end_ms = last_start + s_last_line_ms;
+        }
+        if (m_max_line_duration_ms)
+        {
+            end_ms = std::min(end_ms, start_ms + *m_max_line_duration_ms);
+        }
+        m_end_vector.push_back(end_ms);
+    }
 }
 
 void LyricParser::clear_result()
 {
     m_is_enhanced = EnhancedState::Uninitialized;
     m_lyric_vector.clear();
+    m_word_vector.clear();
+    m_end_vector.clear();
+}
+
+void LyricParser::append(const LyricParser& next)
+{
+    append_lines(next);
+    sort_text_lines();
+    compute_end_times();
+}
+
+void LyricParser::append(const std::vector<const LyricParser*>& parts)
+{
+    size_t line_count = m_lyric_vector.size();
+    size_t word_count = m_word_vector.size();
+    for (const LyricParser* part : parts)
+    {
+        line_count += part->m_lyric_vector.size();
+        word_count += part->m_word_vector.size();
+    }
+    m_lyric_vector.reserve(line_count);
+    m_word_vector.reserve(word_count);
+    for (const LyricParser* part : parts)
+    {
+        append_lines(*part);
+    }
+    sort_text_lines();
+    compute_end_times();
+}
+
+void LyricParser::append_lines(const LyricParser& next)
+{
+    if (m_is_enhanced == EnhancedState::Uninitialized)
+    {
+        m_is_enhanced = next.m_is_enhanced;
+    }
+    const size_t next_tags = next.tag_count();
+    const auto line_offset = static_cast<uint32_t>(m_lyric_vector.size() - tag_count());
+    m_lyric_vector.insert(m_lyric_vector.begin() + static_cast<std::ptrdiff_t>(tag_count())
+                          , next.m_lyric_vector.begin()
+                          , next.m_lyric_vector.begin() + static_cast<std::ptrdiff_t>(next_tags));
+    m_lyric_vector.insert(m_lyric_vector.end()
+                          , next.m_lyric_vector.begin() + static_cast<std::ptrdiff_t>(next_tags)
+                          , next.m_lyric_vector.end());
+    m_word_vector.reserve(m_word_vector.size() + next.m_word_vector.size());
+    for (LyricWord word : next.m_word_vector)
+    {
+        word.m_line += line_offset;
+        m_word_vector.push_back(word);
+    }
 }
 
 void LyricParser::change_encoding_utf8()
 {
+    // word byte ranges move with the conversion, remap them on the GBK text first
+    const size_t text_begin = tag_count();
+    for (auto& word : m_word_vector)
+    {
+        const std::string_view line_text{m_lyric_vector[text_begin + word.m_line].m_text};
+        const std::string prefix = TextFileHelper::convert_encoding(
+            std::string{line_text.substr(0, word.m_offset)}
+            , Encoding::GBK
+            , Encoding::UTF8);
+        const std::string word_text = TextFileHelper::convert_encoding(
+            std::string{line_text.substr(word.m_offset, word.m_length)}
+            , Encoding::GBK
+            , Encoding::UTF8);
+        word.m_offset = static_cast<uint32_t>(prefix.size());
+        word.m_length = static_cast<uint32_t>(word_text.size());
+    }
+
     if (!m_lyric_vector.empty())
     {
         for (auto& lyric : m_lyric_vector)
@@ -180,7 +587,7 @@ void LyricParser::change_encoding_utf8()
             if (!lyric.m_text.empty())
             {
                 lyric.m_text =
-                        TextFileHelper::convert_encoding(lyric.m_text
+                        TextFileHelper::convert_encoding(std::string{lyric.m_text}
                                 ,Encoding::GBK
                                 , Encoding::UTF8
                             );
@@ -0,0 +1,340 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricscheduler.h>
+#include <textfilehelper.h>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <optional>
+
+namespace AudioToolKits
+{
+namespace
+{
+thread_local const LyricWorkStealingPool* t_pool{nullptr};
+
+thread_local size_t t_worker{0};
+}
+
+LyricWorkStealingPool::LyricWorkStealingPool(const size_t thread_count)
+{
+    const size_t count = std::max<size_t>(thread_count, 1);
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_threads.emplace_back(&LyricWorkStealingPool::run, this, i);
+    }
+}
+
+LyricWorkStealingPool::~LyricWorkStealingPool()
+{
+    wait_idle();
+    {
+        const std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_work_available.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void LyricWorkStealingPool::submit(Task task)
+{
+    ++m_pending;
+    const size_t target = t_pool == this
+                              ? t_worker
+                              : m_next_victim.fetch_add(1) % m_workers.size();
+    {
+        const std::lock_guard<std::mutex> lock(m_workers[target]->m_mutex);
+        m_workers[target]->m_tasks.push_back(std::move(task));
+    }
+    {
+        // pairs with the predicate check of sleeping workers, no lost wakeup
+        const std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        ++m_queued;
+    }
+    m_work_available.notify_one();
+}
+
+void LyricWorkStealingPool::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(m_sleep_mutex);
+    m_idle.wait(lock, [this]()
+    {
+        return m_pending == 0;
+    });
+}
+
+LyricPoolStats LyricWorkStealingPool::stats() const
+{
+    LyricPoolStats stats;
+    for (const auto& worker : m_workers)
+    {
+        stats.m_executed.push_back(worker->m_executed);
+    }
+    stats.m_steals = m_steals;
+    stats.m_failed = m_failed;
+    return stats;
+}
+
+bool LyricWorkStealingPool::pop_or_steal(const size_t self, Task& task)
+{
+    // 1. Own deque, newest first
+    {
+        Worker& worker = *m_workers[self];
+        const std::lock_guard<std::mutex> lock(worker.m_mutex);
+        if (!worker.m_tasks.empty())
+        {
+            task = std::move(worker.m_tasks.back());
+            worker.m_tasks.pop_back();
+            --m_queued;
+            return true;
+        }
+    }
+    // 1.
+
+    // 2. Steal the oldest task of the next non-empty victim
+    for (size_t i = 1; i < m_workers.size(); ++i)
+    {
+        Worker& victim = *m_workers[(self + i) % m_workers.size()];
+        const std::lock_guard<std::mutex> lock(victim.m_mutex);
+        if (!victim.m_tasks.empty())
+        {
+            task = std::move(victim.m_tasks.front());
+            victim.m_tasks.pop_front();
+            --m_queued;
+            ++m_steals;
+            return true;
+        }
+    }
+    // 2.
+    return false;
+}
+
+void LyricWorkStealingPool::run(const size_t self)
+{
+    t_pool = this;
+    t_worker = self;
+    for (;;)
+    {
+        Task task;
+        if (pop_or_steal(self, task))
+        {
+            // an escaping exception would terminate the process and leave
+            // m_pending, and every wait_idle(), hanging on the task
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                ++m_failed;
+                std::cerr << "LyricWorkStealingPool: task threw: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                ++m_failed;
+                std::cerr << "LyricWorkStealingPool: task threw an unknown exception" << std::endl;
+            }
+            ++m_workers[self]->m_executed;
+            if (--m_pending == 0)
+            {
+                const std::lock_guard<std::mutex> lock(m_sleep_mutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_work_available.wait(lock, [this]()
+        {
+            return m_stop || m_queued != 0;
+        });
+        if (m_stop && m_queued == 0)
+        {
+            return;
+        }
+    }
+}
+
+LyricDirectoryParser::LyricDirectoryParser(LyricWorkStealingPool& pool, Options options)
+    : m_pool{pool},
+      m_options{std::move(options)}
+{
+    m_options.m_split_lines = std::max<size_t>(m_options.m_split_lines, 1);
+}
+
+void LyricDirectoryParser::parse_tree(const std::filesystem::path& root, Sink sink)
+{
+    auto shared_sink = std::make_shared<Sink>(std::move(sink));
+    m_pool.submit([this, root, shared_sink]()
+    {
+        walk(root, shared_sink);
+    });
+}
+
+void LyricDirectoryParser::parse_file(const std::filesystem::path& file
+                                      , const uintmax_t size
+                                      , Sink sink)
+{
+    schedule_file(file, size, std::make_shared<Sink>(std::move(sink)));
+}
+
+void LyricDirectoryParser::walk(const std::filesystem::path& directory
+                                , const std::shared_ptr<Sink>& sink)
+{
+    std::error_code ec;
+    std::filesystem::directory_iterator it{directory, ec};
+    if (ec)
+    {
+        std::cerr << "LyricDirectoryParser: cannot list " << directory << ": " <<
+                ec.message() << "\n";
+        return;
+    }
+    for (; it != std::filesystem::directory_iterator{}; it.increment(ec))
+    {
+        if (ec)
+        {
+            break;
+        }
+        const auto& entry = *it;
+        if (entry.is_directory(ec))
+        {
+            auto path = entry.path();
+            m_pool.submit([this, path, sink]()
+            {
+                walk(path, sink);
+            });
+        }
+        else if (entry.is_regular_file(ec) && wanted(entry.path()))
+        {
+            schedule_file(entry.path(), entry.file_size(ec), sink);
+        }
+    }
+}
+
+void LyricDirectoryParser::schedule_file(const std::filesystem::path& file
+                                         , const uintmax_t size
+                                         , const std::shared_ptr<Sink>& sink)
+{
+    if (size > m_options.m_split_bytes)
+    {
+        m_pool.submit([this, file, sink]()
+        {
+            parse_split(file, sink);
+        });
+        return;
+    }
+    m_pool.submit([file, sink]()
+    {
+        LyricParsedFile parsed;
+        parsed.m_path = file.string();
+        parsed.m_document = std::make_shared<const LyricParser>(parsed.m_path);
+        (*sink)(std::move(parsed));
+    });
+}
+
+void LyricDirectoryParser::parse_split(const std::filesystem::path& file
+                                       , const std::shared_ptr<Sink>& sink)
+{
+    struct Split
+    {
+        std::string m_path;
+
+        std::vector<std::string> m_lines;
+
+        std::vector<LyricParser> m_chunks;
+
+        std::atomic<size_t> m_remaining{0};
+    };
+
+    auto split = std::make_shared<Split>();
+    split->m_path = file.string();
+    split->m_lines = TextFileHelper{split->m_path}.get_content();
+    const size_t chunk_lines = m_options.m_split_lines;
+    const size_t chunk_count = std::max<size_t>(
+        (split->m_lines.size() + chunk_lines - 1) / chunk_lines, 1);
+    split->m_chunks.resize(chunk_count);
+    split->m_remaining = chunk_count;
+
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+    {
+        m_pool.submit([split, sink, chunk, chunk_lines, chunk_count]()
+        {
+            const size_t first = std::min(chunk * chunk_lines, split->m_lines.size());
+            const size_t last = std::min(first + chunk_lines, split->m_lines.size());
+            if (first != last)
+            {
+                split->m_chunks[chunk].parse_lrc({split->m_lines.begin() + static_cast<std::ptrdiff_t>(first)
+                                                  , split->m_lines.begin() + static_cast<std::ptrdiff_t>(last)});
+            }
+            if (--split->m_remaining != 0)
+            {
+                return;
+            }
+
+            // last chunk to finish merges; the serial parse stops at the first
+            // line that is not a text line and fixes the format on the first
+            // text line, a later chunk is merged only if it agrees on both
+            std::vector<const LyricParser*> parts;
+            std::optional<bool> enhanced;
+            bool reparse{false};
+            for (size_t k = 0; k < chunk_count; ++k)
+            {
+                const LyricParser& part = split->m_chunks[k];
+                const size_t part_tags = part.tag_count();
+                if (k != 0 && part_tags != 0)
+                {
+                    break;
+                }
+                if (part.line_count() > part_tags)
+                {
+                    if (enhanced && *enhanced != part.is_enhanced())
+                    {
+                        reparse = true;
+                        break;
+                    }
+                    enhanced = part.is_enhanced();
+                }
+                parts.push_back(&part);
+                const size_t chunk_size = std::min(chunk_lines, split->m_lines.size() - k * chunk_lines);
+                if (part.line_count() != chunk_size)
+                {
+                    break;
+                }
+            }
+            auto merged = std::make_shared<LyricParser>();
+            if (reparse)
+            {
+                merged->parse_lrc(split->m_lines);
+            }
+            else
+            {
+                merged->append(parts);
+            }
+
+            LyricParsedFile parsed;
+            parsed.m_path = split->m_path;
+            parsed.m_document = std::move(merged);
+            parsed.m_chunks = chunk_count;
+            (*sink)(std::move(parsed));
+        });
+    }
+}
+
+bool LyricDirectoryParser::wanted(const std::filesystem::path& file) const
+{
+    const std::string extension = file.extension().string();
+    return std::any_of(m_options.m_extensions.begin()
+                       , m_options.m_extensions.end()
+                       , [&extension](const std::string& wanted_extension)
+                       {
+                           return extension == wanted_extension;
+                       });
+}
+}
@@ -0,0 +1,54 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricsnapshot.h>
+#include <utility>
+
+namespace AudioToolKits
+{
+LyricSnapshot::LyricSnapshot()
+    : LyricSnapshot(std::make_shared<const LyricParser>())
+{
+}
+
+LyricSnapshot::LyricSnapshot(LyricDocument document)
+    : m_current{document ? std::move(document) : std::make_shared<const LyricParser>()}
+{
+}
+
+LyricSnapshot::~LyricSnapshot() = default;
+
+LyricDocument LyricSnapshot::load() const
+{
+    return std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+}
+
+void LyricSnapshot::publish(LyricDocument document)
+{
+    if (!document)
+    {
+        document = std::make_shared<const LyricParser>();
+    }
+    std::atomic_store_explicit(&m_current
+                               , std::move(document)
+                               , std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+LyricDocument LyricSnapshot::reload_file(const std::string_view file_path)
+{
+    LyricDocument document = parse_file(file_path);
+    publish(document);
+    return document;
+}
+
+uint64_t LyricSnapshot::version() const
+{
+    return m_version.load(std::memory_order_acquire);
+}
+
+LyricDocument LyricSnapshot::parse_file(const std::string_view file_path)
+{
+    return std::make_shared<const LyricParser>(file_path);
+}
+}
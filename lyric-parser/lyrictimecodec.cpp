@@ -0,0 +1,243 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyrictimecodec.h>
+#include <algorithm>
+#include <iostream>
+#include "binaryio.h"
+
+namespace AudioToolKits
+{
+namespace
+{
+uint64_t zigzag(const int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(const uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void put_varint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// nullptr on a truncated or overlong varint
+const char* get_varint(const char* p, const char* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && p != end; shift += 7)
+    {
+        const auto byte = static_cast<unsigned char>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+// Decodes count values of one block starting at p. Deltas of synced lyrics are
+// nearly always 1 or 2 bytes, so 8 bytes are inspected at once and runs of
+// 1-byte or 2-byte varints are decoded without per-byte branches.
+const char* decode_block(const char* p
+                         , const char* end
+                         , size_t count
+                         , int64_t* out)
+{
+    uint64_t raw{0};
+    p = get_varint(p, end, raw);
+    if (p == nullptr || count == 0)
+    {
+        return p;
+    }
+    uint64_t value = static_cast<uint64_t>(unzigzag(raw));
+    *out++ = static_cast<int64_t>(value);
+    --count;
+    while (count != 0)
+    {
+        if (end - p >= 8 && count >= 4)
+        {
+            const uint64_t word = BinaryIO::load_u64(p);
+            const uint64_t stops = word & 0x8080808080808080ULL;
+            if (stops == 0 && count >= 8)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    value += static_cast<uint64_t>(unzigzag((word >> (i * 8)) & 0x7F));
+                    *out++ = static_cast<int64_t>(value);
+                }
+                p += 8;
+                count -= 8;
+                continue;
+            }
+            if (stops == 0x0080008000800080ULL)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    const uint64_t pair = word >> (i * 16);
+                    value += static_cast<uint64_t>(unzigzag((pair & 0x7F) | ((pair >> 1) & 0x3F80)));
+                    *out++ = static_cast<int64_t>(value);
+                }
+                p += 8;
+                count -= 4;
+                continue;
+            }
+        }
+        p = get_varint(p, end, raw);
+        if (p == nullptr)
+        {
+            return nullptr;
+        }
+        value += static_cast<uint64_t>(unzigzag(raw));
+        *out++ = static_cast<int64_t>(value);
+        --count;
+    }
+    return p;
+}
+}
+
+std::string LyricTimeCodec::encode(const int64_t* times
+                                   , const size_t count
+                                   , uint32_t checkpoint_interval)
+{
+    checkpoint_interval = std::max<uint32_t>(checkpoint_interval, 1);
+    const size_t checkpoint_count = (count + checkpoint_interval - 1) / checkpoint_interval;
+
+    std::string out;
+    out.reserve(s_header_size + checkpoint_count * 4 + count * 2);
+    BinaryIO::put_u32(out, static_cast<uint32_t>(count));
+    BinaryIO::put_u32(out, checkpoint_interval);
+    BinaryIO::put_u32(out, static_cast<uint32_t>(checkpoint_count));
+    const size_t checkpoints = out.size();
+    out.resize(out.size() + checkpoint_count * 4);
+    const size_t payload = out.size();
+
+    // deltas wrap in uint64_t, any int64_t sequence round-trips
+    uint64_t previous{0};
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto value = static_cast<uint64_t>(times[i]);
+        if (i % checkpoint_interval == 0)
+        {
+            BinaryIO::patch_u32(out
+                                , checkpoints + i / checkpoint_interval * 4
+                                , static_cast<uint32_t>(out.size() - payload));
+            put_varint(out, zigzag(times[i]));
+        }
+        else
+        {
+            put_varint(out, zigzag(static_cast<int64_t>(value - previous)));
+        }
+        previous = value;
+    }
+    return out;
+}
+
+std::string LyricTimeCodec::encode(const std::vector<int64_t>& times
+                                   , const uint32_t checkpoint_interval)
+{
+    return encode(times.data(), times.size(), checkpoint_interval);
+}
+
+LyricTimeView::LyricTimeView(const char* data, const size_t size)
+{
+    if (data == nullptr || size < LyricTimeCodec::s_header_size)
+    {
+        std::cerr << "LyricTimeView: stream too small\n";
+        return;
+    }
+    const uint32_t count = BinaryIO::load_u32(data);
+    const uint32_t interval = BinaryIO::load_u32(data + 4);
+    const uint32_t checkpoint_count = BinaryIO::load_u32(data + 8);
+    const uint64_t payload_offset = LyricTimeCodec::s_header_size +
+                                    static_cast<uint64_t>(checkpoint_count) * 4;
+    if (interval == 0 ||
+        checkpoint_count != (static_cast<uint64_t>(count) + interval - 1) / interval ||
+        payload_offset > size)
+    {
+        std::cerr << "LyricTimeView: corrupt header\n";
+        return;
+    }
+    for (uint32_t i = 0; i < checkpoint_count; ++i)
+    {
+        if (BinaryIO::load_u32(data + LyricTimeCodec::s_header_size + i * 4) >= size - payload_offset)
+        {
+            std::cerr << "LyricTimeView: checkpoint out of bounds\n";
+            return;
+        }
+    }
+    m_data = data;
+    m_checkpoints = data + LyricTimeCodec::s_header_size;
+    m_payload = data + payload_offset;
+    m_payload_size = size - payload_offset;
+    m_count = count;
+    m_interval = interval;
+}
+
+int64_t LyricTimeView::at(const size_t index) const
+{
+    std::vector<int64_t> value;
+    value.reserve(1);
+    return decode(index, 1, value) ? value.front() : 0;
+}
+
+bool LyricTimeView::decode(const size_t first
+                           , const size_t count
+                           , std::vector<int64_t>& out) const
+{
+    if (!is_valid() || first > m_count || count > m_count - first)
+    {
+        return false;
+    }
+    const size_t base = out.size();
+    out.resize(base + count);
+    const char* end = m_payload + m_payload_size;
+    size_t block = first / m_interval;
+    size_t skip = first % m_interval;
+    size_t written = 0;
+    // one block of scratch when the range starts mid-block
+    std::vector<int64_t> scratch;
+    while (written < count)
+    {
+        const size_t block_size = std::min<size_t>(m_interval, m_count - block * m_interval);
+        const char* p = m_payload + BinaryIO::load_u32(m_checkpoints + block * 4);
+        const size_t wanted = std::min(block_size - skip, count - written);
+        if (skip == 0 && wanted == block_size)
+        {
+            p = decode_block(p, end, block_size, out.data() + base + written);
+        }
+        else
+        {
+            scratch.resize(skip + wanted);
+            p = decode_block(p, end, skip + wanted, scratch.data());
+            std::copy(scratch.begin() + static_cast<std::ptrdiff_t>(skip)
+                      , scratch.end()
+                      , out.begin() + static_cast<std::ptrdiff_t>(base + written));
+        }
+        if (p == nullptr)
+        {
+            out.resize(base);
+            return false;
+        }
+        written += wanted;
+        skip = 0;
+        ++block;
+    }
+    return true;
+}
+
+bool LyricTimeView::decode(std::vector<int64_t>& out) const
+{
+    return decode(0, m_count, out);
+}
+}
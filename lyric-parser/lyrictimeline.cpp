@@ -0,0 +1,152 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyrictimeline.h>
+#include <algorithm>
+
+namespace AudioToolKits
+{
+namespace
+{
+uint32_t count_codepoints(const std::string_view utf8)
+{
+    return static_cast<uint32_t>(std::count_if(utf8.begin()
+                                               , utf8.end()
+                                               , [](const char c)
+                                               {
+                                                   return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+                                               }));
+}
+}
+
+LyricTimeline::LyricTimeline(const LyricParser& parser)
+    : m_is_enhanced{parser.is_enhanced()}
+{
+    // the parser keeps text lines in time order and words grouped by line
+    const auto lines = parser.get_text();
+    const auto& words = parser.get_words();
+    const auto& ends = parser.get_end_ms();
+
+    m_line_start_ms.reserve(lines.size());
+    m_line_end_ms.assign(ends.begin(), ends.end());
+    m_text_offset.reserve(lines.size() + 1);
+    m_line_first_word.reserve(lines.size() + 1);
+    m_word_start_ms.reserve(words.size());
+    m_word_offset.reserve(words.size());
+    m_word_length.reserve(words.size());
+    size_t next_word = 0;
+    for (size_t line = 0; line < lines.size(); ++line)
+    {
+        m_line_start_ms.push_back(lines[line].start_ms());
+        m_text_offset.push_back(static_cast<uint32_t>(m_text_pool.size()));
+        m_text_pool.append(lines[line].m_text);
+        m_line_first_word.push_back(static_cast<uint32_t>(m_word_start_ms.size()));
+        for (; next_word < words.size() && words[next_word].m_line == line; ++next_word)
+        {
+            m_word_start_ms.push_back(words[next_word].m_start_ms);
+            m_word_offset.push_back(words[next_word].m_offset);
+            m_word_length.push_back(words[next_word].m_length);
+        }
+    }
+    m_text_offset.push_back(static_cast<uint32_t>(m_text_pool.size()));
+    m_line_first_word.push_back(static_cast<uint32_t>(m_word_start_ms.size()));
+
+    // word ends and code point ranges, karaoke fill needs them on every frame
+    m_word_end_ms.resize(word_count());
+    m_word_codepoint_offset.resize(word_count());
+    m_word_codepoint_length.resize(word_count());
+    for (size_t line = 0; line < line_count(); ++line)
+    {
+        const std::string_view text = line_text(line);
+        for (size_t word = m_line_first_word[line]; word < m_line_first_word[line + 1]; ++word)
+        {
+            m_word_end_ms[word] = word + 1 < m_line_first_word[line + 1]
+                                      ? m_word_start_ms[word + 1]
+                                      : m_line_end_ms[line];
+            m_word_codepoint_offset[word] = count_codepoints(text.substr(0, m_word_offset[word]));
+            m_word_codepoint_length[word] = count_codepoints(
+                text.substr(m_word_offset[word], m_word_length[word]));
+        }
+    }
+}
+
+std::string_view LyricTimeline::line_text(const size_t line) const
+{
+    return std::string_view{m_text_pool}.substr(
+        m_text_offset[line]
+        , m_text_offset[line + 1] - m_text_offset[line]);
+}
+
+std::string_view LyricTimeline::word_text(const size_t word) const
+{
+    const auto line = static_cast<size_t>(
+        std::upper_bound(m_line_first_word.begin()
+                         , m_line_first_word.end()
+                         , static_cast<uint32_t>(word)) - m_line_first_word.begin()) - 1;
+    return line_text(line).substr(m_word_offset[word], m_word_length[word]);
+}
+
+size_t LyricTimeline::find_line(const int64_t time_ms) const
+{
+    const auto it = std::upper_bound(m_line_start_ms.begin()
+                                     , m_line_start_ms.end()
+                                     , time_ms);
+    return it == m_line_start_ms.begin()
+               ? npos
+               : static_cast<size_t>(it - m_line_start_ms.begin()) - 1;
+}
+
+size_t LyricTimeline::find_word(const size_t line, const int64_t time_ms) const
+{
+    if (line >= line_count())
+    {
+        return npos;
+    }
+    const auto begin = m_word_start_ms.begin() + m_line_first_word[line];
+    const auto end = m_word_start_ms.begin() + m_line_first_word[line + 1];
+    const auto it = std::upper_bound(begin, end, time_ms);
+    return it == begin
+               ? npos
+               : static_cast<size_t>(it - m_word_start_ms.begin()) - 1;
+}
+
+LyricLineRange LyricTimeline::line_range(const int64_t begin_ms
+                                         , const int64_t end_ms
+                                         , const size_t context_before
+                                         , const size_t context_after) const
+{
+    if (end_ms <= begin_ms || line_count() == 0)
+    {
+        return {};
+    }
+    // the line shown at begin_ms, or the first line if none is shown yet
+    const size_t shown = find_line(begin_ms);
+    const size_t first = shown == npos ? 0 : shown;
+    // every line starting before end_ms
+    const auto last = static_cast<size_t>(
+        std::lower_bound(m_line_start_ms.begin(), m_line_start_ms.end(), end_ms) -
+        m_line_start_ms.begin());
+    if (last <= first)
+    {
+        return {};
+    }
+    return {first > context_before ? first - context_before : 0
+            , std::min(line_count(), last + context_after)};
+}
+
+size_t LyricTimeline::memory_usage() const
+{
+    return sizeof(LyricTimeline) +
+           m_line_start_ms.capacity() * sizeof(int64_t) +
+           m_line_end_ms.capacity() * sizeof(int64_t) +
+           m_word_end_ms.capacity() * sizeof(int64_t) +
+           m_word_codepoint_offset.capacity() * sizeof(uint32_t) +
+           m_word_codepoint_length.capacity() * sizeof(uint32_t) +
+           m_text_offset.capacity() * sizeof(uint32_t) +
+           m_text_pool.capacity() +
+           m_line_first_word.capacity() * sizeof(uint32_t) +
+           m_word_start_ms.capacity() * sizeof(int64_t) +
+           m_word_offset.capacity() * sizeof(uint32_t) +
+           m_word_length.capacity() * sizeof(uint32_t);
+}
+}
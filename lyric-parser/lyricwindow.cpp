@@ -0,0 +1,63 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <lyricwindow.h>
+#include <algorithm>
+
+namespace AudioToolKits
+{
+namespace
+{
+// [a.first, a.last) minus [b.first, b.last), as a front and a back part
+void subtract(const LyricLineRange& a
+              , const LyricLineRange& b
+              , LyricLineRange (&result)[2])
+{
+    if (a.empty())
+    {
+        result[0] = {};
+        result[1] = {};
+        return;
+    }
+    if (b.empty())
+    {
+        result[0] = a;
+        result[1] = {};
+        return;
+    }
+    result[0] = {a.m_first, std::min(a.m_last, b.m_first)};
+    result[1] = {std::max(a.m_first, b.m_last), a.m_last};
+}
+}
+
+LyricWindowTracker::LyricWindowTracker(const LyricTimeline& timeline
+                                       , const size_t context_before
+                                       , const size_t context_after)
+    : m_timeline{&timeline},
+      m_context_before{context_before},
+      m_context_after{context_after}
+{
+}
+
+LyricWindowChange LyricWindowTracker::update(const int64_t begin_ms
+                                             , const int64_t end_ms)
+{
+    LyricWindowChange change;
+    change.m_window = m_timeline->line_range(begin_ms
+                                             , end_ms
+                                             , m_context_before
+                                             , m_context_after);
+    if (change.m_window != m_window)
+    {
+        subtract(change.m_window, m_window, change.m_entered);
+        subtract(m_window, change.m_window, change.m_left);
+        m_window = change.m_window;
+    }
+    return change;
+}
+
+void LyricWindowTracker::reset()
+{
+    m_window = {};
+}
+}
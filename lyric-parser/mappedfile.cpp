@@ -0,0 +1,171 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#include <mappedfile.h>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#if defined (_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#include <filesystem>
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace AudioToolKits
+{
+MappedFile::MappedFile(const std::string_view file_path)
+{
+    open(file_path);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#if defined (_WIN32) || defined(_WIN64)
+        m_file_handle = std::exchange(other.m_file_handle, nullptr);
+        m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#if defined (_WIN32) || defined(_WIN64)
+bool MappedFile::open(const std::string_view file_path)
+{
+    close();
+    const std::filesystem::path path{file_path};
+    HANDLE file = CreateFileW(path.c_str()
+                              , GENERIC_READ
+                              , FILE_SHARE_READ
+                              , nullptr
+                              , OPEN_EXISTING
+                              , FILE_ATTRIBUTE_NORMAL
+                              , nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "MappedFile Error: CreateFileW failed, GetLastError: " <<
+                GetLastError() << std::endl;
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        std::cerr << "MappedFile Error: empty or unreadable file" << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0
+                                        , nullptr);
+    if (mapping == nullptr)
+    {
+        std::cerr << "MappedFile Error: CreateFileMappingW failed, GetLastError: "
+                << GetLastError() << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        std::cerr << "MappedFile Error: MapViewOfFile failed, GetLastError: " <<
+                GetLastError() << std::endl;
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file_handle = file;
+    m_mapping_handle = mapping;
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping_handle != nullptr)
+    {
+        CloseHandle(m_mapping_handle);
+    }
+    if (m_file_handle != nullptr)
+    {
+        CloseHandle(m_file_handle);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_file_handle = nullptr;
+    m_mapping_handle = nullptr;
+}
+#elif defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+bool MappedFile::open(const std::string_view file_path)
+{
+    close();
+    const std::string path{file_path};
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "MappedFile Error: open failed: " << strerror(errno) <<
+                std::endl;
+        return false;
+    }
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        std::cerr << "MappedFile Error: empty or unreadable file: " << path <<
+                std::endl;
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr
+                      , static_cast<size_t>(file_stat.st_size)
+                      , PROT_READ
+                      , MAP_SHARED
+                      , fd
+                      , 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        std::cerr << "MappedFile Error: mmap failed: " << strerror(errno) <<
+                std::endl;
+        return false;
+    }
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_t>(file_stat.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
+}
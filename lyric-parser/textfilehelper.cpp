@@ -3,6 +3,7 @@
 //
 #include <textfilehelper.h>
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 
@@ -15,8 +16,40 @@
 
 namespace AudioToolKits
 {
-TextFileHelper::TextFileHelper(const std::string_view filePath)
-    : m_path{filePath}
+namespace
+{
+template <typename String>
+void trim(String& str)
+{
+    if (str.length() >= 3 &&
+        static_cast<unsigned char>(str[0]) == 0xEF &&
+        static_cast<unsigned char>(str[1]) == 0xBB &&
+        static_cast<unsigned char>(str[2]) == 0xBF)
+    {
+        str.erase(0, 3); // Remove the 3-byte UTF-8 BOM
+    }
+    str.erase(str.begin()
+              , std::find_if(str.begin()
+                             , str.end()
+                             , [](const unsigned char ch)
+                             {
+                                 return !std::isspace(ch);
+                             }));
+
+    str.erase(std::find_if(str.rbegin()
+                           , str.rend()
+                           , [](const unsigned char ch)
+                           {
+                               return !std::isspace(ch);
+                           }).base()
+              , str.end());
+}
+}
+
+TextFileHelper::TextFileHelper(const std::string_view filePath
+                               , std::pmr::memory_resource* resource)
+    : m_path{filePath},
+      m_content{resource}
 {
     read_file();
 }
@@ -38,14 +71,16 @@ bool TextFileHelper::read_file()
         std::cerr << "Error: Failed to open file\n";
         return false;
     }
-    std::string read_line;
+    std::pmr::string read_line{m_content.get_allocator()};
     while (std::getline(lyric_stream, read_line))
     {
+        // skipped after the trim like split_lines() does, so a CRLF blank
+        // line ("\r") does not end the parse
+        trim_string(read_line);
         if (read_line.empty())
         {
             continue;
         }
-        trim_string(read_line);
         m_content.emplace_back(std::move(read_line));
     }
     if (m_content.empty())
@@ -58,28 +93,12 @@ bool TextFileHelper::read_file()
 
 void TextFileHelper::trim_string(std::string& str)
 {
-    if (str.length() >= 3 &&
-        static_cast<unsigned char>(str[0]) == 0xEF &&
-        static_cast<unsigned char>(str[1]) == 0xBB &&
-        static_cast<unsigned char>(str[2]) == 0xBF)
-    {
-        str.erase(0, 3); // Remove the 3-byte UTF-8 BOM
-    }
-    str.erase(str.begin()
-              , std::find_if(str.begin()
-                             , str.end()
-                             , [](const unsigned char ch)
-                             {
-                                 return !std::isspace(ch);
-                             }));
+    trim(str);
+}
 
-    str.erase(std::find_if(str.rbegin()
-                           , str.rend()
-                           , [](const unsigned char ch)
-                           {
-                               return !std::isspace(ch);
-                           }).base()
-              , str.end());
+void TextFileHelper::trim_string(std::pmr::string& str)
+{
+    trim(str);
 }
 
 bool TextFileHelper::is_ascii(const std::string& str)
@@ -92,6 +111,100 @@ bool TextFileHelper::is_ascii(const std::string& str)
                        });
 }
 
+bool TextFileHelper::is_utf8(const std::string_view str)
+{
+    const auto* p = reinterpret_cast<const unsigned char*>(str.data());
+    const auto* end = p + str.size();
+    while (p != end)
+    {
+        if (*p < 0x80)
+        {
+            ++p;
+            continue;
+        }
+        size_t length{0};
+        uint32_t min_codepoint{0};
+        uint32_t codepoint{0};
+        if ((*p & 0xE0) == 0xC0)
+        {
+            length = 2;
+            min_codepoint = 0x80;
+            codepoint = *p & 0x1F;
+        }
+        else if ((*p & 0xF0) == 0xE0)
+        {
+            length = 3;
+            min_codepoint = 0x800;
+            codepoint = *p & 0x0F;
+        }
+        else if ((*p & 0xF8) == 0xF0)
+        {
+            length = 4;
+            min_codepoint = 0x10000;
+            codepoint = *p & 0x07;
+        }
+        else
+        {
+            return false;
+        }
+        if (static_cast<size_t>(end - p) < length)
+        {
+            return false;
+        }
+        for (size_t i = 1; i < length; ++i)
+        {
+            if ((p[i] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+            codepoint = (codepoint << 6) | (p[i] & 0x3F);
+        }
+        // overlong forms, surrogates and values past U+10FFFF
+        if (codepoint < min_codepoint || codepoint > 0x10FFFF ||
+            (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+        {
+            return false;
+        }
+        p += length;
+    }
+    return true;
+}
+
+bool TextFileHelper::read_bytes(const std::filesystem::path& file_path, std::string& out)
+{
+    std::ifstream stream(file_path, std::ios::binary | std::ios::in | std::ios::ate);
+    if (!stream.is_open())
+    {
+        std::cerr << "Error: Failed to open file " << file_path.filename() << "\n";
+        return false;
+    }
+    const std::streamoff size = stream.tellg();
+    if (size < 0)
+    {
+        return false;
+    }
+    out.resize(static_cast<size_t>(size));
+    stream.seekg(0);
+    return static_cast<bool>(stream.read(out.data(), size));
+}
+
+std::vector<std::string> TextFileHelper::split_lines(std::string_view bytes)
+{
+    std::vector<std::string> lines;
+    while (!bytes.empty())
+    {
+        const size_t newline = bytes.find('\n');
+        std::string line{bytes.substr(0, newline)};
+        bytes.remove_prefix(newline == std::string_view::npos ? bytes.size() : newline + 1);
+        trim_string(line);
+        if (!line.empty())
+        {
+            lines.emplace_back(std::move(line));
+        }
+    }
+    return lines;
+}
+
 std::string TextFileHelper::encoding_to_string(const Encoding& encoding)
 {
     switch (encoding)
@@ -0,0 +1,197 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyricbinary.h>
+#include <lyrictimecodec.h>
+#include <climits>
+#include <cstdio>
+
+TEST_CASE("LyricBinaryRoundTripTest", "Compiled binary lyric format")
+{
+    const std::string filename{"binary_test.lyc"};
+    const std::string compiled_name{"binary_test.lrcb"};
+    const std::vector<std::string> lrc_toT{
+        "[ar: Carpenters]"
+        , "[ti: Yesterday Once More]"
+        , "[00:10.500] When I was young I'd listen to the radio"
+        , "[00:14.250] Waitin' for my favorite songs"
+        , "[00:18.000] 歌词测试"
+        , "[00:21.750] It made me smile"
+    };
+
+    LPTest::ScopedFile fileHelper(filename);
+    fileHelper.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::UTF8);
+    const AudioToolKits::LyricParser lyric_parser{filename};
+
+    SECTION("Mapped file exposes the parser results")
+    {
+        LPTest::ScopedFile compiledHelper(compiled_name);
+        REQUIRE(AudioToolKits::LyricCompiler::compile_to_file(lyric_parser
+                                                             , compiled_name));
+        const AudioToolKits::LyricBinaryReader reader{compiled_name};
+        REQUIRE(reader.is_valid());
+        REQUIRE(reader.is_enhanced() == lyric_parser.is_enhanced());
+        REQUIRE(reader.get_tags() == lyric_parser.get_tags());
+        REQUIRE(reader.get_text() == lyric_parser.get_text());
+        REQUIRE(reader.text(2) == "歌词测试");
+    }
+
+    SECTION("Seek index resolves the active line")
+    {
+        const std::string bytes = AudioToolKits::LyricCompiler::compile(lyric_parser);
+        const AudioToolKits::LyricBinaryView view{bytes.data(), bytes.size()};
+        REQUIRE(view.is_valid());
+        REQUIRE_FALSE(view.find_line(0).has_value());
+        REQUIRE(view.find_line(10500) == 0u);
+        REQUIRE(view.find_line(14249) == 0u);
+        REQUIRE(view.find_line(14250) == 1u);
+        REQUIRE(view.find_line(20000) == 2u);
+        REQUIRE(view.find_line(99999999) == 3u);
+    }
+
+    SECTION("Corrupt data is rejected")
+    {
+        std::string bytes = AudioToolKits::LyricCompiler::compile(lyric_parser);
+        bytes[0] = 'X';
+        const AudioToolKits::LyricBinaryView bad_magic{bytes.data(), bytes.size()};
+        REQUIRE_FALSE(bad_magic.is_valid());
+
+        const std::string truncated =
+                AudioToolKits::LyricCompiler::compile(lyric_parser).substr(0, 80);
+        const AudioToolKits::LyricBinaryView bad_size{truncated.data(), truncated.size()};
+        REQUIRE_FALSE(bad_size.is_valid());
+    }
+}
+
+TEST_CASE("LyricBinaryWordTest", "Word timings in the compiled format")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc({
+        "[ti: words]"
+        , "[00:05.123] <00:05.123> And <00:05.300> I <00:05.450> remember"
+        , "[00:15.000] <00:15.000> 窗 <00:15.200> 透"
+    });
+    const std::string bytes = AudioToolKits::LyricCompiler::compile(lyric_parser);
+    const AudioToolKits::LyricBinaryView view{bytes.data(), bytes.size()};
+    REQUIRE(view.is_valid());
+    REQUIRE(view.is_enhanced());
+    REQUIRE(view.word_count() == lyric_parser.get_words().size());
+    for (size_t i = 0; i < view.word_count(); ++i)
+    {
+        REQUIRE(view.word(i) == lyric_parser.get_words()[i]);
+    }
+    const auto last = view.word(view.word_count() - 1);
+    REQUIRE(view.text(last.m_line).substr(last.m_offset, last.m_length) == "透");
+}
+
+TEST_CASE("LyricTimeCodecTest", "Delta varint timestamp streams")
+{
+    std::vector<int64_t> times;
+    for (int64_t i = 0; i < 300; ++i)
+    {
+        // 1-byte, 2-byte and wide deltas, and a step back
+        times.push_back(i * (i % 3 == 0 ? 30 : 4000) + (i == 150 ? -100000 : 0));
+    }
+    times.push_back(INT64_MIN);
+    times.push_back(INT64_MAX);
+
+    const std::string bytes = AudioToolKits::LyricTimeCodec::encode(times, 16);
+    const AudioToolKits::LyricTimeView view{bytes.data(), bytes.size()};
+    REQUIRE(view.is_valid());
+    REQUIRE(view.size() == times.size());
+
+    SECTION("Full and partial decode")
+    {
+        std::vector<int64_t> decoded;
+        REQUIRE(view.decode(decoded));
+        REQUIRE(decoded == times);
+
+        std::vector<int64_t> range;
+        REQUIRE(view.decode(37, 100, range));
+        REQUIRE(range == std::vector<int64_t>(times.begin() + 37, times.begin() + 137));
+        REQUIRE(view.at(150) == times[150]);
+        REQUIRE(view.at(times.size() - 1) == INT64_MAX);
+        REQUIRE_FALSE(view.decode(290, 100, range));
+    }
+
+    SECTION("Monotonic line times shrink at least 3x")
+    {
+        std::vector<int64_t> lines;
+        for (int64_t i = 0; i < 600; ++i)
+        {
+            lines.push_back(i * 3750 + i % 7 * 13);
+        }
+        const std::string encoded = AudioToolKits::LyricTimeCodec::encode(lines);
+        REQUIRE(encoded.size() * 3 < lines.size() * sizeof(int64_t));
+    }
+
+    SECTION("Corrupt streams are rejected")
+    {
+        const AudioToolKits::LyricTimeView truncated_header{bytes.data(), 8};
+        REQUIRE_FALSE(truncated_header.is_valid());
+
+        std::string truncated = bytes.substr(0, bytes.size() - 3);
+        const AudioToolKits::LyricTimeView truncated_payload{truncated.data(), truncated.size()};
+        std::vector<int64_t> decoded;
+        REQUIRE(truncated_payload.is_valid());
+        REQUIRE_FALSE(truncated_payload.decode(decoded));
+        REQUIRE(decoded.empty());
+    }
+}
+
+TEST_CASE("LyricBinaryLongFormTest", "Seek index over multi-day timelines")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc({
+        "[00:00.000] start"
+        , "[10:00:00.000] ten hours"
+        , "[2000:00:00.000] almost three months"
+    });
+    const std::string bytes = AudioToolKits::LyricCompiler::compile(lyric_parser);
+    const AudioToolKits::LyricBinaryView view{bytes.data(), bytes.size()};
+    REQUIRE(view.is_valid());
+    REQUIRE(view.start_ms(2) == int64_t{2000} * 3600000);
+    REQUIRE(view.find_line(36000000 - 1) == 0u);
+    REQUIRE(view.find_line(36000000) == 1u);
+    REQUIRE(view.find_line(int64_t{2000} * 3600000 - 1) == 1u);
+    REQUIRE(view.find_line(int64_t{2000} * 3600000) == 2u);
+}
+
+TEST_CASE("LyricBinaryDenseSeekTest", "Lines clustered inside a few seek buckets")
+{
+    // a long sparse track with one dense section, most lines share a bucket
+    std::vector<std::string> lrc_toT{"[00:00.000] intro"};
+    for (int i = 0; i < 500; ++i)
+    {
+        const int ms = 600000 + i * 7;
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "[%02d:%02d.%03d]", ms / 60000, ms / 1000 % 60, ms % 1000);
+        lrc_toT.push_back(std::string{stamp} + " dense");
+    }
+    lrc_toT.emplace_back("[59:00.000] outro");
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc(lrc_toT);
+    const std::string bytes = AudioToolKits::LyricCompiler::compile(lyric_parser);
+    const AudioToolKits::LyricBinaryView view{bytes.data(), bytes.size()};
+    REQUIRE(view.is_valid());
+    REQUIRE(view.line_count() == 502);
+
+    const auto linear = [&view](const int64_t time_ms)
+    {
+        std::optional<size_t> result;
+        for (size_t i = 0; i < view.line_count() && view.start_ms(i) <= time_ms; ++i)
+        {
+            result = i;
+        }
+        return result;
+    };
+    for (int64_t time_ms = 599990; time_ms < 603600; time_ms += 3)
+    {
+        REQUIRE(view.find_line(time_ms) == linear(time_ms));
+    }
+    REQUIRE(view.find_line(0) == 0u);
+    REQUIRE(view.find_line(3540000) == 501u);
+}
@@ -0,0 +1,103 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyriccache.h>
+#include <thread>
+
+TEST_CASE("LyricCacheFileTest", "LRU cache keyed by path")
+{
+    const std::string filename{"cache_test.lyc"};
+    const std::vector<std::string> lrc_toT{
+        "[ar: Carpenters]"
+        , "[00:10.500] When I was young I'd listen to the radio"
+        , "[00:14.250] Waitin' for my favorite songs"
+    };
+
+    LPTest::ScopedFile fileHelper(filename);
+    fileHelper.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::UTF8);
+
+    SECTION("Repeated lookups share one document")
+    {
+        AudioToolKits::LyricCache cache{1 << 20, 4};
+        const auto first = cache.get_file(filename);
+        const auto second = cache.get_file(filename);
+        REQUIRE(first == second);
+        REQUIRE(first->get_text().size() == 2);
+
+        const auto stats = cache.stats();
+        REQUIRE(stats.m_hits == 1);
+        REQUIRE(stats.m_misses == 1);
+        REQUIRE(stats.m_loads == 1);
+        REQUIRE(stats.m_entries == 1);
+        REQUIRE(stats.m_bytes >= first->memory_usage());
+    }
+
+    SECTION("Modified file is reloaded")
+    {
+        AudioToolKits::LyricCache cache{1 << 20, 4};
+        const auto first = cache.get_file(filename);
+        auto changed = lrc_toT;
+        changed.emplace_back("[00:18.000] When they played I'd sing along");
+        fileHelper.write_to_file(changed, LPTest::ScopedFile::Encoding::UTF8);
+        const auto second = cache.get_file(filename);
+        REQUIRE(first != second);
+        REQUIRE(second->get_text().size() == 3);
+    }
+
+    SECTION("Concurrent misses parse once")
+    {
+        AudioToolKits::LyricCache cache{1 << 20, 1};
+        std::vector<std::thread> threads;
+        std::vector<AudioToolKits::LyricCache::Document> results(8);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            threads.emplace_back([&cache, &results, &filename, i]()
+            {
+                results[i] = cache.get_file(filename);
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(cache.stats().m_loads == 1);
+        for (const auto& result : results)
+        {
+            REQUIRE(result == results.front());
+        }
+    }
+}
+
+TEST_CASE("LyricCacheBudgetTest", "LRU eviction under a byte budget")
+{
+    std::vector<std::vector<std::string>> contents;
+    for (int i = 0; i < 8; ++i)
+    {
+        contents.push_back({
+            "[ti: song " + std::to_string(i) + "]"
+            , "[00:01.000] a line long enough to leave the small string buffer " +
+              std::to_string(i)
+        });
+    }
+
+    AudioToolKits::LyricCache probe{1 << 20, 1};
+    const size_t one_entry = probe.get_content(contents[0])->memory_usage();
+
+    // room for roughly three documents
+    AudioToolKits::LyricCache cache{one_entry * 3 + 512, 1};
+    for (const auto& content : contents)
+    {
+        cache.get_content(content);
+    }
+    const auto stats = cache.stats();
+    REQUIRE(stats.m_evictions > 0);
+    REQUIRE(stats.m_bytes <= cache.byte_budget());
+    REQUIRE(stats.m_entries < contents.size());
+
+    // the most recent document is still resident
+    cache.get_content(contents.back());
+    REQUIRE(cache.stats().m_hits == 1);
+}
@@ -0,0 +1,140 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <lyriccompact.h>
+#include <lyricintern.h>
+#include <algorithm>
+#include <thread>
+
+TEST_CASE("LyricCompactStoreTest", "Compact line representation")
+{
+    AudioToolKits::LyricParser first;
+    first.parse_lrc({
+        "[ar: Carpenters]"
+        , "[ti: Yesterday Once More]"
+        , "[00:10.500] When I was young I'd listen to the radio"
+        , "[00:18.000] 歌词测试"
+    });
+    AudioToolKits::LyricParser second;
+    second.parse_lrc({
+        "[00:05.123] <00:05.123> 窗 <00:05.300> 透"
+    });
+
+    AudioToolKits::LyricCompactStore store;
+    const uint32_t first_id = store.add(first);
+    const uint32_t second_id = store.add(second);
+
+    SECTION("Round trip through the shared pool")
+    {
+        REQUIRE(sizeof(AudioToolKits::LyricCompactLine) == 12);
+        REQUIRE(store.document_count() == 2);
+        REQUIRE(store.lines(first_id) == first.get_lrc());
+        REQUIRE(store.lines(second_id) == second.get_lrc());
+        REQUIRE(store.line(first_id, 0).isTag());
+        REQUIRE(store.text(store.line(first_id, 3)) == "歌词测试");
+        REQUIRE(store.line(second_id, 0).start_ms() == 5123);
+        REQUIRE(store.memory_usage() <
+                AudioToolKits::LyricCompactStore::memory_usage(first.get_lrc()) +
+                AudioToolKits::LyricCompactStore::memory_usage(second.get_lrc()));
+    }
+
+    SECTION("Times past 32 bits are rejected")
+    {
+        const std::vector<AudioToolKits::LyricLine> too_long{
+            {int64_t{1} << 32, "far away"}
+        };
+        REQUIRE(store.add(too_long) == AudioToolKits::LyricCompactStore::npos);
+        REQUIRE(store.document_count() == 2);
+    }
+}
+
+TEST_CASE("LyricCompactChorusTest", "Repeated lines share pool bytes")
+{
+    AudioToolKits::LyricParser chorus;
+    chorus.parse_lrc({
+        "[00:51.997]雨打湿了眼眶 年年倚井盼归堂"
+        , "[00:59.997]最怕不觉泪已拆两行"
+        , "[02:12.667]雨打湿了眼眶 年年倚井盼归堂"
+    });
+    AudioToolKits::LyricCompactStore store;
+    const uint32_t id = store.add(chorus);
+    REQUIRE(store.line(id, 0).m_offset == store.line(id, 2).m_offset);
+    REQUIRE(store.lines(id) == chorus.get_lrc());
+}
+
+TEST_CASE("LyricInternTableTest", "Corpus-wide string interning")
+{
+    const auto table = std::make_shared<AudioToolKits::LyricInternTable>();
+    AudioToolKits::LyricParser first;
+    first.parse_lrc({
+        "[ar: 许嵩]"
+        , "[00:00.000] 作词 : 许嵩"
+        , "[00:26.988] 窗透初晓 日照西桥 云自摇"
+    });
+    AudioToolKits::LyricParser second;
+    second.parse_lrc({
+        "[ar: 许嵩]"
+        , "[00:00.000] 作词 : 许嵩"
+        , "[00:33.680] 想你当年荷风微摆的衣角"
+    });
+
+    SECTION("Documents on one table share their strings")
+    {
+        const AudioToolKits::LyricInternedDocument first_doc{first, table};
+        const AudioToolKits::LyricInternedDocument second_doc{second, table};
+        REQUIRE(first_doc.get_lrc() == first.get_lrc());
+        REQUIRE(second_doc.get_lrc() == second.get_lrc());
+        REQUIRE(first_doc.tag("ar") == std::string_view{"许嵩"});
+        REQUIRE_FALSE(first_doc.tag("ti").has_value());
+        REQUIRE(first_doc.lines()[1].m_text.data() == second_doc.lines()[1].m_text.data());
+        REQUIRE(first_doc.lines()[0].m_key.data() == second_doc.lines()[0].m_key.data());
+
+        const auto stats = table->stats();
+        // 3 texts and 1 key per document, the tag, its key and the credit repeat
+        REQUIRE(stats.m_lookups == 8);
+        REQUIRE(stats.m_hits == 3);
+        REQUIRE(stats.m_strings == 5);
+        REQUIRE(stats.dedup_ratio() > 1.0);
+    }
+
+    SECTION("Concurrent interning returns one copy")
+    {
+        std::vector<std::thread> threads;
+        std::vector<const char*> data(4);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            threads.emplace_back([&table, &data, i]()
+            {
+                for (int round = 0; round < 1000; ++round)
+                {
+                    data[i] = table->intern("编曲 : 许嵩").data();
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(std::all_of(data.begin()
+                            , data.end()
+                            , [&data](const char* p)
+                            {
+                                return p == data.front();
+                            }));
+        REQUIRE(table->stats().m_strings == 1);
+    }
+
+    SECTION("Without a table repeats inside the document are shared")
+    {
+        AudioToolKits::LyricParser chorus;
+        chorus.parse_lrc({
+            "[00:01.000] 最怕不觉泪已拆两行"
+            , "[00:05.000] 最怕不觉泪已拆两行"
+        });
+        const AudioToolKits::LyricInternedDocument document{chorus};
+        REQUIRE(document.lines()[0].m_text.data() == document.lines()[1].m_text.data());
+        REQUIRE(document.table()->stats().m_strings == 1);
+    }
+}
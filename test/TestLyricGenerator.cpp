@@ -0,0 +1,164 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyricgenerator.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static_assert(LYRIC_PARSER_HAS_GENERATOR == 1);
+
+namespace
+{
+// a line whose conversion throws, as a failed allocation in the parse would
+struct ThrowingLine
+{
+    std::string m_text;
+
+    operator std::string_view() const
+    {
+        if (m_text == "throw")
+        {
+            throw std::runtime_error("line unavailable");
+        }
+        return m_text;
+    }
+};
+
+std::vector<AudioToolKits::LyricLine> collect(AudioToolKits::LyricLineGenerator generator)
+{
+    std::vector<AudioToolKits::LyricLine> lines;
+    for (const auto& line : generator)
+    {
+        if (line.isTag())
+        {
+            lines.emplace_back(line.m_text);
+        }
+        else
+        {
+            lines.emplace_back(line.start_ms(), line.m_text);
+        }
+    }
+    return lines;
+}
+}
+
+TEST_CASE("LyricGeneratorTest", "Lazy line-by-line parse")
+{
+    const std::vector<std::string> lrc_toT{
+        "[ti: Generator]"
+        , "[ar: 测试]"
+        , "[00:03.000] third"
+        , "[00:01.000] 第一行"
+        , "[00:02.000] second"
+    };
+
+    SECTION("Same lines as parse_lrc in input order")
+    {
+        AudioToolKits::LyricParser lyric_parser;
+        lyric_parser.parse_lrc(lrc_toT);
+        const auto lines = collect(AudioToolKits::LyricLineGenerator::from_lines(lrc_toT));
+        REQUIRE(lines.size() == lyric_parser.get_lrc().size());
+        REQUIRE(lines[0].m_text == "ti: Generator");
+        REQUIRE(lines[1].m_text == "ar: 测试");
+        const auto text = lyric_parser.get_text();
+        REQUIRE(lines[2] == text[2]);
+        REQUIRE(lines[3] == text[0]);
+        REQUIRE(lines[4] == text[1]);
+    }
+
+    SECTION("Buffers yield the same lines")
+    {
+        std::string buffer;
+        for (const auto& line : lrc_toT)
+        {
+            buffer += line + "\r\n\n";
+        }
+        REQUIRE(collect(AudioToolKits::LyricLineGenerator::from_buffer(buffer))
+                == collect(AudioToolKits::LyricLineGenerator::from_lines(lrc_toT)));
+        REQUIRE(collect(AudioToolKits::LyricLineGenerator::from_buffer(" \r\n")).empty());
+    }
+
+    SECTION("Breaking out leaves the rest unparsed")
+    {
+        std::vector<std::string> lines;
+        size_t count{0};
+        for (const auto& line : AudioToolKits::LyricLineGenerator::from_lines(lrc_toT))
+        {
+            lines.emplace_back(line.m_text);
+            if (++count == 3)
+            {
+                break;
+            }
+        }
+        REQUIRE(lines == std::vector<std::string>{"ti: Generator", "ar: 测试", "third"});
+    }
+
+    SECTION("Stops where parse_lrc stops")
+    {
+        const std::vector<std::string> stray_toT{
+            "[00:01.000] one"
+            , "stray"
+            , "[00:02.000] never"
+        };
+        const auto lines = collect(AudioToolKits::LyricLineGenerator::from_lines(stray_toT));
+        REQUIRE(lines.size() == 1);
+        REQUIRE(lines[0].m_text == "one");
+    }
+
+    SECTION("Enhanced lines carry their words")
+    {
+        const std::vector<std::string> enhanced_toT{
+            "[00:05.000] <00:05.000> Hello <00:05.500> world"
+            , "[00:06.000] <00:06.000> 早 <00:06.300> 安"
+        };
+        std::vector<std::vector<AudioToolKits::LyricWord>> words;
+        std::vector<std::string> texts;
+        for (const auto& line : AudioToolKits::LyricLineGenerator::from_lines(enhanced_toT))
+        {
+            texts.emplace_back(line.m_text);
+            words.emplace_back(line.m_words.begin(), line.m_words.end());
+        }
+        REQUIRE(texts == std::vector<std::string>{"Hello world", "早安"});
+        REQUIRE(words.size() == 2);
+        REQUIRE(words[0].size() == 2);
+        REQUIRE(words[0][1].m_start_ms == 5500);
+        REQUIRE(words[0][1].m_offset == 6);
+        REQUIRE(words[1].size() == 2);
+        REQUIRE(words[1][0].m_line == 1);
+        REQUIRE(texts[1].substr(words[1][1].m_offset, words[1][1].m_length) == "安");
+    }
+
+    SECTION("Exceptions reach the consumer")
+    {
+        const std::vector<ThrowingLine> lines{{"[00:01.000] one"}, {"throw"}, {"[00:02.000] two"}};
+        std::vector<std::string> texts;
+        auto generator = AudioToolKits::LyricLineGenerator::from_range(lines.begin(), lines.end());
+        const auto consume = [&generator, &texts]()
+        {
+            for (const auto& line : generator)
+            {
+                texts.emplace_back(line.m_text);
+            }
+        };
+        REQUIRE_THROWS_AS(consume(), std::runtime_error);
+        REQUIRE(texts == std::vector<std::string>{"one"});
+
+        const std::vector<ThrowingLine> first_throws{{"throw"}};
+        auto failed = AudioToolKits::LyricLineGenerator::from_range(first_throws.begin(), first_throws.end());
+        REQUIRE_THROWS_AS(failed.begin(), std::runtime_error);
+    }
+
+    SECTION("Files are decoded before parsing")
+    {
+        const std::string filename{"generator.lrc"};
+        LPTest::ScopedFile scoped_file{filename};
+        REQUIRE(scoped_file.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::GBK));
+        REQUIRE(collect(AudioToolKits::LyricLineGenerator::from_file(filename))
+                == collect(AudioToolKits::LyricLineGenerator::from_lines(lrc_toT)));
+        REQUIRE(collect(AudioToolKits::LyricLineGenerator::from_file("missing.lrc")).empty());
+    }
+}
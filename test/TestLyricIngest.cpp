@@ -0,0 +1,379 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyricingest.h>
+#include <lyricloader.h>
+#include <lyricscheduler.h>
+#include <algorithm>
+#include <cerrno>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+TEST_CASE("LyricIngestPipelineTest", "Staged read, decode, parse and index")
+{
+    const std::vector<std::string> lrc_toT{
+        "[ti: 清明雨上]"
+        , "[00:26.988]窗透初晓 日照西桥 云自摇"
+        , "[00:33.680]想你当年荷风微摆的衣角"
+    };
+    LPTest::ScopedFile utf8_file("ingest_utf8.lyc");
+    utf8_file.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::UTF8);
+    LPTest::ScopedFile gbk_file("ingest_gbk.lyc");
+    gbk_file.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::GBK);
+
+    std::mutex mutex;
+    std::vector<AudioToolKits::LyricIngestItem> results;
+    AudioToolKits::LyricIngestConfig config;
+    config.m_parse_threads = 3;
+    config.m_queue_capacity = 1;
+    AudioToolKits::LyricIngestPipeline pipeline{
+        config
+        , [&mutex, &results](AudioToolKits::LyricIngestItem&& item)
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(std::move(item));
+        }
+    };
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 10; ++i)
+    {
+        paths.emplace_back(i % 2 == 0 ? "ingest_utf8.lyc" : "ingest_gbk.lyc");
+    }
+    paths.emplace_back("ingest_missing.lyc");
+    const auto stats = pipeline.run(paths);
+
+    REQUIRE(results.size() == 10);
+    for (const auto& item : results)
+    {
+        REQUIRE(item.m_document->get_tags() == std::vector<std::string>{"ti: 清明雨上"});
+        REQUIRE(item.m_timeline->line_count() == 2);
+        REQUIRE(item.m_timeline->line_text(1) == "想你当年荷风微摆的衣角");
+        REQUIRE(item.m_encoding == (item.m_path == "ingest_gbk.lyc"
+                                        ? AudioToolKits::Encoding::GBK
+                                        : AudioToolKits::Encoding::UTF8));
+        REQUIRE(item.m_bytes.empty());
+        REQUIRE(item.m_lines.empty());
+    }
+
+    const auto& read = stats.m_stages[AudioToolKits::LyricIngestPipeline::Read];
+    REQUIRE(read.m_items == 10);
+    REQUIRE(read.m_errors == 1);
+    REQUIRE(read.m_threads == 2);
+    REQUIRE(stats.m_stages[AudioToolKits::LyricIngestPipeline::Parse].m_threads == 3);
+    REQUIRE(stats.m_stages[AudioToolKits::LyricIngestPipeline::Index].m_items == 10);
+    // a queue of capacity 1 never holds more
+    REQUIRE(std::all_of(stats.m_stages.begin()
+                        , stats.m_stages.end()
+                        , [](const AudioToolKits::LyricStageStats& stage)
+                        {
+                            return stage.m_max_queue_depth <= 1;
+                        }));
+}
+
+TEST_CASE("LyricIngestPipelineThrowTest", "A throwing sink only drops its item")
+{
+    LPTest::ScopedFile lrc_file("ingest_throw.lyc");
+    lrc_file.write_to_file({"[00:01.000] 窗透初晓"});
+
+    std::atomic<int> calls{0};
+    AudioToolKits::LyricIngestPipeline pipeline{
+        {}
+        , [&calls](AudioToolKits::LyricIngestItem&&)
+        {
+            if (++calls % 2 == 0)
+            {
+                throw std::runtime_error("sink failed");
+            }
+        }
+    };
+    const auto stats = pipeline.run(std::vector<std::string>(6, "ingest_throw.lyc"));
+
+    REQUIRE(calls == 6);
+    const auto& index = stats.m_stages[AudioToolKits::LyricIngestPipeline::Index];
+    REQUIRE(index.m_items == 3);
+    REQUIRE(index.m_errors == 3);
+}
+
+TEST_CASE("TextFileHelperUtf8Test", "Encoding detection")
+{
+    REQUIRE(AudioToolKits::TextFileHelper::is_utf8("plain ascii"));
+    REQUIRE(AudioToolKits::TextFileHelper::is_utf8("窗透初晓"));
+    // "窗" in GBK
+    REQUIRE_FALSE(AudioToolKits::TextFileHelper::is_utf8("\xB4\xB0"));
+    // overlong '/'
+    REQUIRE_FALSE(AudioToolKits::TextFileHelper::is_utf8("\xC0\xAF"));
+    REQUIRE(AudioToolKits::TextFileHelper::split_lines("\xEF\xBB\xBF a \r\n\r\nb\n") ==
+            std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("LyricLineSplitParityTest", "Every reader splits lines alike")
+{
+    // a CRLF blank line and a whitespace-only one between the text lines
+    const std::string bytes{"[ti:x]\r\n[00:01.00]a\r\n\r\n \t\r\n[00:02.00]b\r\n"};
+    const std::string filename{"split_parity.lyc"};
+    LPTest::ScopedFile scoped_file(filename);
+    std::ofstream{filename, std::ios::binary} << bytes;
+
+    const AudioToolKits::LyricParser from_path{filename};
+    AudioToolKits::LyricParser from_buffer;
+    from_buffer.parse_buffer(bytes);
+    REQUIRE(from_path.get_text().size() == 2);
+    REQUIRE(from_path.get_lrc() == from_buffer.get_lrc());
+    REQUIRE(AudioToolKits::TextFileHelper{filename}.get_content() ==
+            AudioToolKits::TextFileHelper::split_lines(bytes));
+
+    std::vector<AudioToolKits::LyricLine> visited;
+    std::vector<AudioToolKits::LyricWord> words;
+    AudioToolKits::LyricLineCollector collector{visited, words};
+    REQUIRE(AudioToolKits::LyricParser::visit_file(filename, collector));
+    REQUIRE(visited == from_path.get_lrc());
+
+    size_t ingested{0};
+    AudioToolKits::LyricIngestPipeline pipeline{
+        {}
+        , [&ingested](AudioToolKits::LyricIngestItem&& item)
+        {
+            ingested = item.m_timeline->line_count();
+        }
+    };
+    pipeline.run({filename});
+    REQUIRE(ingested == from_path.get_text().size());
+}
+
+TEST_CASE("LyricBatchLoaderTest", "Batched whole-file loads")
+{
+    const std::vector<std::string> lrc_toT{
+        "[ti: loader]"
+        , "[00:01.000] 窗透初晓"
+    };
+    LPTest::ScopedFile first("loader_first.lyc");
+    first.write_to_file(lrc_toT);
+    LPTest::ScopedFile empty("loader_empty.lyc");
+    std::ofstream{"loader_empty.lyc"};
+    std::string expected;
+    REQUIRE(AudioToolKits::TextFileHelper::read_bytes("loader_first.lyc", expected));
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 100; ++i)
+    {
+        paths.emplace_back(i % 10 == 0 ? "loader_missing.lyc" : "loader_first.lyc");
+    }
+    paths.emplace_back("loader_empty.lyc");
+
+    for (const auto backend : {AudioToolKits::LyricBatchLoader::Backend::IoUring
+                               , AudioToolKits::LyricBatchLoader::Backend::ThreadPool})
+    {
+        // IoUring falls back to the thread pool where it is unavailable
+        const AudioToolKits::LyricBatchLoader loader{backend, 8, 3};
+        std::mutex mutex;
+        size_t matching{0};
+        size_t failed{0};
+        size_t empty_files{0};
+        const auto stats = loader.load(paths
+                                       , [&](AudioToolKits::LyricLoadedFile&& file)
+                                       {
+                                           const std::lock_guard<std::mutex> lock(mutex);
+                                           if (!file.m_ok)
+                                           {
+                                               ++failed;
+                                           }
+                                           else if (file.m_bytes.empty())
+                                           {
+                                               ++empty_files;
+                                           }
+                                           else if (file.m_bytes == expected)
+                                           {
+                                               ++matching;
+                                           }
+                                       });
+        REQUIRE(matching == 90);
+        REQUIRE(failed == 10);
+        REQUIRE(empty_files == 1);
+        REQUIRE(stats.m_files == 91);
+        REQUIRE(stats.m_failed == 10);
+        REQUIRE(stats.m_bytes == 90 * expected.size());
+        REQUIRE(stats.m_syscalls > 0);
+    }
+}
+
+TEST_CASE("LyricDirectoryParserTest", "Work-stealing parse of a directory tree")
+{
+    const std::filesystem::path root{"scheduler_tree"};
+    std::filesystem::create_directories(root / "a" / "b");
+    std::vector<std::string> large{"[ti: large]"};
+    for (int i = 0; i < 20; ++i)
+    {
+        large.push_back("[00:" + std::to_string(10 + i) + ".000] line " + std::to_string(i));
+    }
+    // the serial parse stops here, so must the merge
+    large.emplace_back("[ar: stray]");
+    large.emplace_back("[00:59.000] never parsed");
+    std::vector<std::string> mixed{
+        "[00:01.000] <00:01.000> enhanced <00:01.500> first"
+        , "[00:02.000] <00:02.000> enhanced"
+        , "[00:03.000] <00:03.000> enhanced"
+        // the second chunk alone would be detected as standard LRC
+        , "[00:04.000] plain"
+    };
+    const std::map<std::string, std::vector<std::string>> files{
+        {(root / "small.lrc").string(), {"[00:01.000] small"}}
+        , {(root / "a" / "b" / "large.lrc").string(), large}
+        , {(root / "a" / "mixed.lrc").string(), mixed}
+        , {(root / "a" / "ignored.txt").string(), {"[00:01.000] ignored"}}
+    };
+    for (const auto& [path, lines] : files)
+    {
+        std::ofstream out{path, std::ios::binary};
+        for (const auto& line : lines)
+        {
+            out << line << '\n';
+        }
+    }
+
+    std::mutex mutex;
+    std::map<std::string, AudioToolKits::LyricParsedFile> parsed;
+    {
+        AudioToolKits::LyricWorkStealingPool pool{3};
+        AudioToolKits::LyricDirectoryParser::Options options;
+        options.m_split_bytes = 64;
+        options.m_split_lines = 3;
+        AudioToolKits::LyricDirectoryParser parser{pool, options};
+        parser.parse_tree(root
+                          , [&mutex, &parsed](AudioToolKits::LyricParsedFile&& file)
+                          {
+                              const std::lock_guard<std::mutex> lock(mutex);
+                              parsed[file.m_path] = std::move(file);
+                          });
+        pool.wait_idle();
+        const auto stats = pool.stats();
+        REQUIRE(stats.m_executed.size() == 3);
+    }
+
+    REQUIRE(parsed.size() == 3);
+    for (const auto& [path, file] : parsed)
+    {
+        const AudioToolKits::LyricParser serial{path};
+        REQUIRE(file.m_document->get_lrc() == serial.get_lrc());
+        REQUIRE(file.m_document->get_words() == serial.get_words());
+        REQUIRE(file.m_document->get_end_ms() == serial.get_end_ms());
+        REQUIRE(file.m_document->is_enhanced() == serial.is_enhanced());
+    }
+    REQUIRE(parsed[(root / "a" / "b" / "large.lrc").string()].m_chunks == 8);
+    REQUIRE(parsed[(root / "small.lrc").string()].m_chunks == 1);
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("LyricWorkStealingPoolTest", "Throwing tasks do not take the pool down")
+{
+    AudioToolKits::LyricWorkStealingPool pool{2};
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        pool.submit([&ran, i]()
+        {
+            ++ran;
+            if (i % 2 == 0)
+            {
+                throw std::runtime_error{"task " + std::to_string(i)};
+            }
+            if (i == 3)
+            {
+                throw 3;
+            }
+        });
+    }
+    pool.wait_idle();
+    REQUIRE(ran == 8);
+    REQUIRE(pool.stats().m_failed == 5);
+}
+
+TEST_CASE("LyricBatchLoaderSubmitErrorTest", "io_uring_enter failing mid-batch")
+{
+    LPTest::ScopedFile first("loader_error.lyc");
+    first.write_to_file({"[ti: loader]", "[00:01.000] 窗透初晓"});
+    std::string expected;
+    REQUIRE(AudioToolKits::TextFileHelper::read_bytes("loader_error.lyc", expected));
+    std::vector<std::string> paths;
+    for (int i = 0; i < 100; ++i)
+    {
+        paths.emplace_back(i % 10 == 0 ? "loader_error_missing.lyc" : "loader_error.lyc");
+    }
+    const auto open_fds = []()
+    {
+        size_t count{0};
+#if defined(__linux__)
+        for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator{"/proc/self/fd"})
+        {
+            ++count;
+        }
+#endif
+        return count;
+    };
+    const auto run = [&paths, &expected](const AudioToolKits::LyricBatchLoader& loader
+                                         , size_t& matching
+                                         , size_t& failed)
+    {
+        std::mutex mutex;
+        matching = failed = 0;
+        return loader.load(paths
+                           , [&](AudioToolKits::LyricLoadedFile&& file)
+                           {
+                               const std::lock_guard<std::mutex> lock(mutex);
+                               if (!file.m_ok)
+                               {
+                                   ++failed;
+                               }
+                               else if (file.m_bytes == expected)
+                               {
+                                   ++matching;
+                               }
+                           });
+    };
+    size_t matching{0};
+    size_t failed{0};
+
+    SECTION("EAGAIN and EBUSY are retried")
+    {
+        for (const int error_number : {EAGAIN, EBUSY})
+        {
+            AudioToolKits::LyricBatchLoader loader{AudioToolKits::LyricBatchLoader::Backend::IoUring, 8, 3};
+            loader.inject_submit_error(error_number, 1, 3);
+            const auto stats = run(loader, matching, failed);
+            REQUIRE(matching == 90);
+            REQUIRE(failed == 10);
+            REQUIRE(stats.m_files == 90);
+            REQUIRE(stats.m_failed == 10);
+        }
+    }
+
+    SECTION("A broken ring settles its files and hands the rest on")
+    {
+        AudioToolKits::LyricBatchLoader loader{AudioToolKits::LyricBatchLoader::Backend::IoUring, 8, 3};
+        loader.inject_submit_error(EIO, 1);
+        const size_t fds_before = open_fds();
+        const auto stats = run(loader, matching, failed);
+        REQUIRE(stats.m_files + stats.m_failed == paths.size());
+        REQUIRE(matching + failed == paths.size());
+        REQUIRE(stats.m_files == matching);
+        REQUIRE(open_fds() == fds_before);
+        if (loader.backend() == AudioToolKits::LyricBatchLoader::Backend::IoUring)
+        {
+            // the files in flight when the ring broke fail on top of the 10
+            // missing ones, no file finishes its close within the first round
+            REQUIRE(failed > 10);
+            REQUIRE(failed <= 10 + 8);
+        }
+        else
+        {
+            REQUIRE(failed == 10);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyricpack.h>
+
+TEST_CASE("LyricPackBuildAndFindTest", "Indexed lyric pack")
+{
+    const std::string pack_name{"pack_test.lrcp"};
+    const std::string first_name{"pack_first.lyc"};
+    const std::string second_name{"pack_second.lyc"};
+    const std::vector<std::string> first_toT{
+        "[ar: Carpenters]"
+        , "[ti: Yesterday Once More]"
+        , "[00:10.500] When I was young I'd listen to the radio"
+        , "[00:14.250] Waitin' for my favorite songs"
+    };
+    const std::vector<std::string> second_toT{
+        "[标签: 测试标签]"
+        , "[00:00.001] Test lyric"
+        , "[00:01.010] 歌词测试"
+    };
+
+    LPTest::ScopedFile packHelper(pack_name);
+    LPTest::ScopedFile firstHelper(first_name);
+    LPTest::ScopedFile secondHelper(second_name);
+    firstHelper.write_to_file(first_toT, LPTest::ScopedFile::Encoding::UTF8);
+    secondHelper.write_to_file(second_toT, LPTest::ScopedFile::Encoding::UTF8);
+    const AudioToolKits::LyricParser first_parser{first_name};
+    const AudioToolKits::LyricParser second_parser{second_name};
+
+    {
+        AudioToolKits::LyricPackBuilder builder{pack_name};
+        builder.add_file(first_name);
+        builder.add(AudioToolKits::LyricPack::song_id_key(42), second_parser);
+        REQUIRE(builder.commit());
+    }
+
+    SECTION("Lookup by key")
+    {
+        const AudioToolKits::LyricPackReader reader{pack_name};
+        REQUIRE(reader.is_valid());
+        REQUIRE(reader.entry_count() == 2);
+
+        const auto first = reader.find(AudioToolKits::LyricPack::path_key(first_name));
+        REQUIRE(first.has_value());
+        REQUIRE(first->get_text() == first_parser.get_text());
+
+        const auto second = reader.find(AudioToolKits::LyricPack::song_id_key(42));
+        REQUIRE(second.has_value());
+        REQUIRE(second->get_tags() == second_parser.get_tags());
+
+        REQUIRE_FALSE(reader.find(AudioToolKits::LyricPack::song_id_key(7)).has_value());
+    }
+
+    SECTION("Append, replace and compact")
+    {
+        {
+            AudioToolKits::LyricPackBuilder builder{pack_name};
+            REQUIRE(builder.entry_count() == 2);
+            builder.add(AudioToolKits::LyricPack::artist_title_key("Carpenters"
+                                                                   , "Yesterday Once More")
+                        , first_parser);
+            builder.add(AudioToolKits::LyricPack::song_id_key(42), first_parser);
+            REQUIRE(builder.commit());
+        }
+        {
+            const AudioToolKits::LyricPackReader reader{pack_name};
+            REQUIRE(reader.entry_count() == 3);
+            REQUIRE(reader.dead_bytes() > 0);
+            const auto replaced = reader.find(AudioToolKits::LyricPack::song_id_key(42));
+            REQUIRE(replaced.has_value());
+            REQUIRE(replaced->get_text() == first_parser.get_text());
+        }
+
+        const auto size_before = std::filesystem::file_size(pack_name);
+        REQUIRE(AudioToolKits::LyricPackBuilder::compact(pack_name));
+        REQUIRE(std::filesystem::file_size(pack_name) < size_before);
+
+        const AudioToolKits::LyricPackReader reader{pack_name};
+        REQUIRE(reader.entry_count() == 3);
+        REQUIRE(reader.dead_bytes() == 0);
+        REQUIRE(reader.find(AudioToolKits::LyricPack::artist_title_key("Carpenters"
+                                                                       , "Yesterday Once More"))
+                        .has_value());
+    }
+}
+
+TEST_CASE("LyricPackForeignFileTest", "Never overwrite what is not a pack")
+{
+    const std::string pack_name{"pack_garbage.lrcp"};
+    const std::string first_name{"pack_garbage.lyc"};
+    const std::vector<std::string> garbage_toT{
+        "not a lyric pack"
+        , "but somebody's notes"
+    };
+    LPTest::ScopedFile packHelper(pack_name);
+    LPTest::ScopedFile firstHelper(first_name);
+    REQUIRE(packHelper.write_to_file(garbage_toT, LPTest::ScopedFile::Encoding::UTF8));
+    REQUIRE(firstHelper.write_to_file({"[00:01.000] line"}, LPTest::ScopedFile::Encoding::UTF8));
+    const auto size_before = std::filesystem::file_size(pack_name);
+
+    AudioToolKits::LyricPackBuilder builder{pack_name};
+    REQUIRE_FALSE(builder.is_valid());
+    builder.add_file(first_name);
+    REQUIRE_FALSE(builder.commit());
+    REQUIRE_FALSE(AudioToolKits::LyricPackBuilder::compact(pack_name));
+    REQUIRE(std::filesystem::file_size(pack_name) == size_before);
+    REQUIRE_FALSE(AudioToolKits::LyricPackReader{pack_name}.is_valid());
+}
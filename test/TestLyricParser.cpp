@@ -5,6 +5,12 @@
 #include "scopedfile.h"
 #include "catch.hpp"
 #include <lyricparser.h>
+#include <lyricstatic.h>
+#include <lyricgenerator.h>
+#include <cstdint>
+
+// the generator header compiles away below C++20
+static_assert(__cplusplus >= 202002L || LYRIC_PARSER_HAS_GENERATOR == 0);
 
 TEST_CASE("LyricParserChineseNormalTest", "Normal-LRC Test")
 {
@@ -169,4 +175,508 @@ TEST_CASE("LyricParserYesterdayOnceMoreEnhancedTest", "YOM-Enhanced-LRC Test")
         REQUIRE(lyric_parser.get_tags() == expected_tags);
         REQUIRE(lyric_parser.get_text() == expected_content_lines);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("LyricParserEndTimeTest", "Inferred line end times")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc({
+        "[ti: End Times]"
+        , "[length: 01:30.50]"
+        , "[00:20.000] <00:20.000> 想 <00:20.200> 你"
+        , "[00:05.000] <00:05.000> first"
+        , "[00:10.000] <00:10.000> second <00:10.500> line"
+    });
+
+    SECTION("Lines are sorted and end at the next start or [length:]")
+    {
+        const std::vector<AudioToolKits::LyricLine> expected_content_lines{
+            {5000, "first"},
+            {10000, "second line"},
+            {20000, "想你"}
+        };
+        REQUIRE(lyric_parser.get_text() == expected_content_lines);
+        REQUIRE(lyric_parser.length_ms() == 90500);
+        REQUIRE(lyric_parser.get_end_ms() == std::vector<int64_t>{10000, 20000, 90500});
+
+        // words follow their line through the sort
+        const auto& words = lyric_parser.get_words();
+        REQUIRE(words.size() == 5);
+        REQUIRE(words[0].m_line == 0);
+        REQUIRE(words[2].m_line == 1);
+        REQUIRE(words[4].m_line == 2);
+        REQUIRE(words[4].m_start_ms == 20200);
+    }
+
+    SECTION("Instrumental gaps are capped")
+    {
+        lyric_parser.set_max_line_duration_ms(8000);
+        REQUIRE(lyric_parser.get_end_ms() == std::vector<int64_t>{10000, 18000, 28000});
+        lyric_parser.set_max_line_duration_ms(std::nullopt);
+        REQUIRE(lyric_parser.get_end_ms().back() == 90500);
+    }
+
+    SECTION("Without [length:] the last line outlives its last word")
+    {
+        AudioToolKits::LyricParser no_length;
+        no_length.parse_lrc({
+            "[00:01.000] <00:01.000> a <00:02.000> b"
+        });
+        REQUIRE(no_length.get_end_ms() ==
+                std::vector<int64_t>{2000 + AudioToolKits::LyricParser::s_last_line_ms});
+    }
+
+    SECTION("Hundredths mean the same in line stamps and [length:]")
+    {
+        AudioToolKits::LyricParser hundredths;
+        hundredths.parse_lrc({
+            "[length: 01:30.50]"
+            , "[01:20.05] <01:20.05> a <01:25.500> b <01:30.25> c"
+            , "[01:30.50] at the end"
+        });
+        REQUIRE(hundredths.get_text()[0].start_ms() == 80050);
+        REQUIRE(hundredths.get_text()[1].start_ms() == 90500);
+        REQUIRE(hundredths.length_ms() == hundredths.get_text()[1].start_ms());
+        REQUIRE(hundredths.get_words()[1].m_start_ms == 85500);
+        REQUIRE(hundredths.get_words()[2].m_start_ms == 90250);
+        REQUIRE(AudioToolKits::LyricParser::time_to_ms("01:30.50") == 90500);
+        REQUIRE(AudioToolKits::LyricParser::time_to_ms("01", "30", "50") == 90500);
+        REQUIRE(AudioToolKits::LyricParser::time_to_ms("01", "30", "500") == 90500);
+    }
+}
+
+TEST_CASE("LyricParserMemoryResourceTest", "Parsing into a caller supplied arena")
+{
+    const std::string filename{"arena_test.lyc"};
+    const std::vector<std::string> lrc_toT{
+        "[ti: Arena]"
+        , "[00:01.000] <00:01.000> 窗外的麻雀 <00:02.000> 在电线杆上多嘴"
+        , "[00:05.000] <00:05.000> 你说这一句 <00:06.000> 很有夏天的感觉"
+    };
+    LPTest::ScopedFile fileHelper(filename);
+    fileHelper.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::UTF8);
+
+    const AudioToolKits::LyricParser heap_parser{filename};
+    std::pmr::monotonic_buffer_resource arena;
+    {
+        const AudioToolKits::LyricParser arena_parser{filename, &arena};
+        REQUIRE(arena_parser.resource() == &arena);
+        REQUIRE(arena_parser.get_tags() == heap_parser.get_tags());
+        REQUIRE(arena_parser.get_text() == heap_parser.get_text());
+        REQUIRE(arena_parser.get_words() == heap_parser.get_words());
+
+        // copies handed out are plain std::string lines, independent of the arena
+        const std::string text = arena_parser.get_text().front().m_text;
+        REQUIRE(text == "窗外的麻雀在电线杆上多嘴");
+    }
+    arena.release();
+}
+
+TEST_CASE("LyricParserParallelParseTest", "Large inputs parsed in chunks")
+{
+    std::vector<std::string> lrc_toT{"[ti: Chunks]", "[ar: Parallel]"};
+    for (int i = 0; i < 100; ++i)
+    {
+        const int ms = i * 1250 + (i % 4 == 1 ? 2000 : 0);
+        const std::string stamp = "0" + std::to_string(ms / 60000) + ":" +
+                                  (ms / 1000 % 60 < 10 ? "0" : "") + std::to_string(ms / 1000 % 60) + "." +
+                                  std::to_string(100 + ms % 1000).substr(1);
+        lrc_toT.push_back("[" + stamp + "] <" + stamp + "> line" + std::to_string(i) + " <" + stamp + "> 词");
+    }
+    AudioToolKits::LyricParser serial;
+    serial.set_parallel_parse(SIZE_MAX);
+    serial.parse_lrc(lrc_toT);
+    REQUIRE(serial.get_text().size() == 100);
+
+    AudioToolKits::LyricParser chunked;
+    chunked.set_parallel_parse(0, 3);
+
+    SECTION("Chunked parse matches the serial parse")
+    {
+        chunked.parse_lrc(lrc_toT);
+        REQUIRE(chunked.is_enhanced());
+        REQUIRE(chunked.get_tags() == serial.get_tags());
+        REQUIRE(chunked.get_text() == serial.get_text());
+        REQUIRE(chunked.get_words() == serial.get_words());
+        REQUIRE(chunked.get_end_ms() == serial.get_end_ms());
+    }
+
+    SECTION("The first text line decides the format of every chunk")
+    {
+        lrc_toT[2] = "[00:00.000] plain";
+        AudioToolKits::LyricParser plain;
+        plain.set_parallel_parse(SIZE_MAX);
+        plain.parse_lrc(lrc_toT);
+        chunked.parse_lrc(lrc_toT);
+        REQUIRE_FALSE(chunked.is_enhanced());
+        REQUIRE(chunked.get_words().empty());
+        REQUIRE(chunked.get_text() == plain.get_text());
+    }
+
+    SECTION("A stray line ends the parse inside a later chunk")
+    {
+        lrc_toT[80] = "stray";
+        AudioToolKits::LyricParser stopped;
+        stopped.set_parallel_parse(SIZE_MAX);
+        stopped.parse_lrc(lrc_toT);
+        chunked.parse_lrc(lrc_toT);
+        REQUIRE(chunked.get_text().size() == 78);
+        REQUIRE(chunked.get_text() == stopped.get_text());
+        REQUIRE(chunked.get_words() == stopped.get_words());
+    }
+
+    SECTION("Whole buffers split at newlines")
+    {
+        std::string buffer;
+        for (const auto& line : lrc_toT)
+        {
+            buffer += line + "\r\n";
+        }
+        chunked.parse_buffer(buffer);
+        REQUIRE(chunked.get_text() == serial.get_text());
+    }
+}
+
+TEST_CASE("LyricParserLongFormTimeTest", "Hours and 3+ digit minutes")
+{
+    SECTION("Line stamps past 99:59.999")
+    {
+        AudioToolKits::LyricParser lyric_parser;
+        lyric_parser.parse_lrc({
+            "[ti: Audiobook]"
+            , "[00:59.500] Chapter one"
+            , "[99:59.999] still short"
+            , "[100:00.000] past the old limit"
+            , "[1:40:00.250] one hour forty"
+            , "[10:30:15.125] ten hours"
+            , "[1234567:00.00] the longest minutes field"
+        });
+        const auto text = lyric_parser.get_text();
+        REQUIRE(text.size() == 6);
+        REQUIRE(text[0].start_ms() == 59500);
+        REQUIRE(text[1].start_ms() == 5999999);
+        REQUIRE(text[2].start_ms() == 6000000);
+        REQUIRE(text[3].start_ms() == 6000250);
+        REQUIRE(text[4].start_ms() == 37815125);
+        REQUIRE(text[4].m_text == "ten hours");
+        REQUIRE(text[5].start_ms() == int64_t{1234567} * 60000);
+    }
+
+    SECTION("Word stamps in either form")
+    {
+        AudioToolKits::LyricParser lyric_parser;
+        lyric_parser.parse_lrc({
+            "[99:59.999] <99:59.999> still <1:40:00.500> short"
+            , "[10:30:15.125] <10:30:15.125> ten <630:16.000> hours"
+        });
+        REQUIRE(lyric_parser.get_text()[1].m_text == "ten hours");
+        const auto& words = lyric_parser.get_words();
+        REQUIRE(words.size() == 4);
+        REQUIRE(words[1].m_start_ms == 6000500);
+        REQUIRE(words[2].m_start_ms == 37815125);
+        REQUIRE(words[3].m_start_ms == 37816000);
+    }
+
+    REQUIRE(AudioToolKits::LyricParser::time_to_ms("2:00:00.000") == 7200000);
+    REQUIRE(AudioToolKits::LyricParser::time_to_ms("120:00.000") == 7200000);
+}
+
+namespace
+{
+struct RecordingSink
+{
+    std::vector<std::string> m_tags;
+
+    std::vector<std::pair<int64_t, std::string>> m_lines;
+
+    std::vector<std::string> m_words;
+
+    void on_tag(const std::string_view key)
+    {
+        m_tags.emplace_back(key);
+    }
+
+    void on_line_begin(int64_t)
+    {
+    }
+
+    void on_word(int64_t, uint32_t, const std::string_view text)
+    {
+        m_words.emplace_back(text);
+    }
+
+    void on_line_end(const int64_t start_ms, const std::string_view text)
+    {
+        m_lines.emplace_back(start_ms, std::string{text});
+    }
+};
+
+template <typename Format, typename Tags, typename Trim>
+RecordingSink parse_with(const std::vector<std::string>& lrc)
+{
+    AudioToolKits::LyricParseCore<Format, Tags, Trim> core;
+    RecordingSink sink;
+    core.parse_text(core.parse_tags(lrc.begin(), lrc.end(), sink), lrc.end(), sink);
+    return sink;
+}
+}
+
+TEST_CASE("LyricParseCorePolicyTest", "Compile-time parser variants")
+{
+    using namespace AudioToolKits::LyricPolicy;
+    const std::vector<std::string> lrc_toT{
+        "[ti: Policies]"
+        , "[00:01.000]  <00:01.000> Hello <00:01.500> world  "
+        , "[00:03.000] <00:03.000> 窗 <00:03.200> 透"
+    };
+
+    SECTION("Auto, capture and trim match LyricParser")
+    {
+        AudioToolKits::LyricParser lyric_parser;
+        lyric_parser.parse_lrc(lrc_toT);
+        const auto sink = parse_with<AutoFormat, CaptureTags, TrimText>(lrc_toT);
+        REQUIRE(sink.m_tags == lyric_parser.get_tags());
+        REQUIRE(sink.m_lines.size() == 2);
+        REQUIRE(sink.m_lines[0].second == std::string_view{lyric_parser.get_text()[0].m_text});
+        REQUIRE(sink.m_lines[1].second == std::string_view{lyric_parser.get_text()[1].m_text});
+        REQUIRE(sink.m_words.size() == lyric_parser.get_words().size());
+    }
+
+    SECTION("Standard format keeps word stamps, skipped tags are consumed")
+    {
+        const auto sink = parse_with<StandardFormat, SkipTags, TrimText>(lrc_toT);
+        REQUIRE(sink.m_tags.empty());
+        REQUIRE(sink.m_words.empty());
+        REQUIRE(sink.m_lines.size() == 2);
+        REQUIRE(sink.m_lines[0].first == 1000);
+        REQUIRE(sink.m_lines[0].second == "<00:01.000> Hello <00:01.500> world");
+    }
+
+    SECTION("Enhanced format without trimming")
+    {
+        const auto sink = parse_with<EnhancedFormat, CaptureTags, KeepText>(lrc_toT);
+        REQUIRE(sink.m_words == std::vector<std::string>{" Hello ", " world  ", " 窗 ", " 透"});
+        REQUIRE(sink.m_lines[1].second == " 窗  透");
+    }
+}
+
+namespace
+{
+constexpr std::string_view s_builtin_lrc{
+    "\xEF\xBB\xBF[ti: Built-in]\r\n"
+    "[length: 00:20.00]\n"
+    "\n"
+    "[00:12.000] third\n"
+    "[00:01.500]  first  \n"
+    "[1:00:00.000] late\n"
+    "[00:05.000] second\n"
+    "not a lyric line\n"
+    "[00:30.000] after the stop\n"
+};
+
+constexpr auto s_builtin = LYRIC_STATIC_DOCUMENT(s_builtin_lrc);
+
+static_assert(s_builtin.tag_count() == 2);
+static_assert(s_builtin.line_count() == 4);
+static_assert(s_builtin.line_start_ms(0) == 1500);
+static_assert(s_builtin.line_text(0) == "first");
+static_assert(s_builtin.line_end_ms(3) == 3600000 + AudioToolKits::LyricParser::s_last_line_ms);
+static_assert(s_builtin.find_line(1499) == s_builtin.npos);
+static_assert(s_builtin.find_line(12000) == 2);
+static_assert(s_builtin.length_ms() == 20000);
+static_assert(!s_builtin.is_enhanced());
+}
+
+TEST_CASE("LyricStaticDocumentTest", "Compile-time parse of a literal")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_buffer(s_builtin_lrc);
+
+    const auto tags = lyric_parser.get_tags();
+    REQUIRE(tags.size() == s_builtin.tag_count());
+    for (size_t i = 0; i < tags.size(); ++i)
+    {
+        REQUIRE(tags[i] == s_builtin.tag(i));
+    }
+    const auto text = lyric_parser.get_text();
+    REQUIRE(text.size() == s_builtin.line_count());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        REQUIRE(text[i].start_ms() == s_builtin.line_start_ms(i));
+        REQUIRE(std::string_view{text[i].m_text} == s_builtin.line_text(i));
+        REQUIRE(lyric_parser.get_end_ms()[i] == s_builtin.line_end_ms(i));
+    }
+
+    static constexpr std::string_view enhanced_lrc{
+        "[ti: Words]\n"
+        "[00:05.000] <00:05.000> 窗外的 <00:05.500> 麻雀\n"
+        "[00:01.00] <00:01.00> a <00:02.00> b\n"
+        "[00:03.000] <00:03.000>  it's <> <00:03.200> <00:04.000> 夏天 <00:04.500> over \n"
+    };
+    static constexpr auto enhanced = LYRIC_STATIC_DOCUMENT(enhanced_lrc);
+    static_assert(enhanced.is_enhanced());
+    static_assert(enhanced.tag_count() == 1);
+    static_assert(enhanced.line_text(0) == "a b");
+    static_assert(enhanced.line_end_ms(2) == 5500 + AudioToolKits::LyricParser::s_last_line_ms);
+
+    AudioToolKits::LyricParser enhanced_parser;
+    enhanced_parser.parse_buffer(enhanced_lrc);
+    const auto enhanced_text = enhanced_parser.get_text();
+    REQUIRE(enhanced_text.size() == enhanced.line_count());
+    for (size_t i = 0; i < enhanced_text.size(); ++i)
+    {
+        REQUIRE(enhanced_text[i].start_ms() == enhanced.line_start_ms(i));
+        REQUIRE(std::string_view{enhanced_text[i].m_text} == enhanced.line_text(i));
+        REQUIRE(enhanced_parser.get_end_ms()[i] == enhanced.line_end_ms(i));
+    }
+}
+
+TEST_CASE("LyricSyntaxTest", "Regex-free line grammar")
+{
+    using AudioToolKits::LyricSyntax;
+    static_assert(LyricSyntax::match_text("[01:02.345] a")->m_start_ms == 62345);
+    static_assert(LyricSyntax::match_text("[1:02:03.04] a")->m_start_ms == 3723040);
+    static_assert(LyricSyntax::match_text("[01:02.345.678]")->m_text.empty());
+    static_assert(!LyricSyntax::match_text("[12345678:00.00] 8 minute digits"));
+    static_assert(!LyricSyntax::match_text("[01:02.3] 1 fraction digit"));
+    static_assert(!LyricSyntax::match_text("[01:02:03:04.00] 4 fields"));
+    static_assert(!LyricSyntax::match_text("[01.00] 1 field"));
+    static_assert(!LyricSyntax::match_text("[01:02.345"));
+    static_assert(LyricSyntax::match_tag("[ar: x]") == std::string_view{"ar: x"});
+    static_assert(!LyricSyntax::match_tag("[ar: x] y"));
+    static_assert(LyricSyntax::match_time("1:00:00.000") == 3600000);
+    static_assert(!LyricSyntax::match_time("01:00.000.000"));
+    static_assert(!LyricSyntax::match_time("01:02.50."));
+    static_assert(!LyricSyntax::match_text("[00:01.00.00.] hi"));
+    static_assert(!LyricSyntax::match_text("[00:01.00.] hi"));
+    static_assert(!LyricSyntax::has_word_stamp("a <> b <c"));
+
+    // "<>" is not a stamp, the text before the first stamp is dropped
+    size_t pos{0};
+    const std::string_view text{"lead <> x <00:01.00> one <00:02.00>two"};
+    const auto first = LyricSyntax::next_word(text, pos);
+    REQUIRE(first);
+    REQUIRE(first->m_stamp == "00:01.00");
+    REQUIRE(first->m_word == " one ");
+    const auto second = LyricSyntax::next_word(text, pos);
+    REQUIRE(second);
+    REQUIRE(second->m_word == "two");
+    REQUIRE_FALSE(LyricSyntax::next_word(text, pos));
+}
+
+namespace
+{
+class EventLog final : public AudioToolKits::LyricVisitor
+{
+public:
+    std::vector<std::string> m_events;
+
+    std::vector<AudioToolKits::LyricDiagnostic> m_diagnostics;
+
+    void on_tag(const std::string_view key) override
+    {
+        m_events.push_back("tag " + std::string{key});
+    }
+
+    void on_line_begin(const int64_t start_ms) override
+    {
+        m_events.push_back("begin " + std::to_string(start_ms));
+    }
+
+    void on_word(const int64_t start_ms, const uint32_t offset, const std::string_view text) override
+    {
+        m_events.push_back("word " + std::to_string(start_ms) + " " + std::to_string(offset) + " " +
+                           std::string{text});
+    }
+
+    void on_line_end(const int64_t start_ms, const std::string_view text) override
+    {
+        m_events.push_back("end " + std::to_string(start_ms) + " " + std::string{text});
+    }
+
+    void on_diagnostic(const AudioToolKits::LyricDiagnostic& diagnostic) override
+    {
+        m_diagnostics.push_back(diagnostic);
+    }
+};
+}
+
+TEST_CASE("LyricVisitorTest", "Streaming parse events")
+{
+    const std::vector<std::string> lrc_toT{
+        "[ti: Visitor]"
+        , "[00:05.000] <00:05.000> Hello <00:05.500> world"
+        , "[00:01.000] <00:01.000> 早"
+        , "stray"
+        , "[00:09.000] <00:09.000> never"
+    };
+
+    SECTION("Events in input order with diagnostics")
+    {
+        EventLog log;
+        AudioToolKits::LyricParser::visit_lrc(lrc_toT, log);
+        REQUIRE(log.m_events == std::vector<std::string>{
+            "tag ti: Visitor"
+            , "begin 5000"
+            , "word 5000 0 Hello"
+            , "word 5500 6 world"
+            , "end 5000 Hello world"
+            , "begin 1000"
+            , "word 1000 0 早"
+            , "end 1000 早"
+        });
+        REQUIRE(log.m_diagnostics.size() == 2);
+        REQUIRE(log.m_diagnostics[0].m_kind == AudioToolKits::LyricDiagnostic::Kind::OutOfOrder);
+        REQUIRE(log.m_diagnostics[0].m_line == 2);
+        REQUIRE(log.m_diagnostics[0].m_text == lrc_toT[2]);
+        REQUIRE(log.m_diagnostics[1].m_kind == AudioToolKits::LyricDiagnostic::Kind::Stopped);
+        REQUIRE(log.m_diagnostics[1].m_line == 3);
+        REQUIRE(log.m_diagnostics[1].m_text == "stray");
+    }
+
+    SECTION("Buffers and GBK files stream the same events")
+    {
+        std::string buffer;
+        for (const auto& line : lrc_toT)
+        {
+            buffer += line + "\r\n\n";
+        }
+        EventLog from_lines;
+        EventLog from_buffer;
+        AudioToolKits::LyricParser::visit_lrc(lrc_toT, from_lines);
+        AudioToolKits::LyricParser::visit_buffer(buffer, from_buffer);
+        REQUIRE(from_buffer.m_events == from_lines.m_events);
+        REQUIRE(from_buffer.m_diagnostics.size() == 2);
+
+        const std::string filename{"visitor_gbk.lyc"};
+        LPTest::ScopedFile fileHelper(filename);
+        fileHelper.write_to_file(lrc_toT, LPTest::ScopedFile::Encoding::GBK);
+        EventLog from_file;
+        REQUIRE(AudioToolKits::LyricParser::visit_file(filename, from_file));
+        REQUIRE(from_file.m_events == from_lines.m_events);
+        EventLog missing;
+        REQUIRE_FALSE(AudioToolKits::LyricParser::visit_file("visitor_missing.lyc", missing));
+
+        EventLog empty;
+        AudioToolKits::LyricParser::visit_buffer(" \r\n", empty);
+        REQUIRE(empty.m_events.empty());
+        REQUIRE(empty.m_diagnostics.size() == 1);
+        REQUIRE(empty.m_diagnostics[0].m_kind == AudioToolKits::LyricDiagnostic::Kind::EmptyInput);
+    }
+
+    SECTION("The collector is what LyricParser keeps")
+    {
+        std::vector<AudioToolKits::LyricLine> lines;
+        std::vector<AudioToolKits::LyricWord> words;
+        AudioToolKits::LyricLineCollector collector{lines, words};
+        AudioToolKits::LyricParser::visit_lrc(lrc_toT, collector);
+
+        AudioToolKits::LyricParser lyric_parser;
+        lyric_parser.parse_lrc(lrc_toT);
+        REQUIRE(lines.size() == lyric_parser.get_lrc().size());
+        // the parser sorts, the stream keeps input order
+        REQUIRE(lines[1] == lyric_parser.get_text()[1]);
+        REQUIRE(lines[2] == lyric_parser.get_text()[0]);
+        REQUIRE(words.size() == lyric_parser.get_words().size());
+    }
+}
@@ -0,0 +1,216 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyricsnapshot.h>
+#include <lyricasync.h>
+#include <lyricscheduler.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+TEST_CASE("LyricSnapshotPublishTest", "Immutable snapshots swapped on reload")
+{
+    const std::string short_name{"snapshot_short.lyc"};
+    const std::string long_name{"snapshot_long.lyc"};
+    const std::vector<std::string> short_toT{
+        "[ti: short]"
+        , "[00:01.000] one"
+    };
+    const std::vector<std::string> long_toT{
+        "[ti: long]"
+        , "[00:01.000] one"
+        , "[00:02.000] two"
+        , "[00:03.000] three"
+    };
+
+    LPTest::ScopedFile shortHelper(short_name);
+    LPTest::ScopedFile longHelper(long_name);
+    shortHelper.write_to_file(short_toT, LPTest::ScopedFile::Encoding::UTF8);
+    longHelper.write_to_file(long_toT, LPTest::ScopedFile::Encoding::UTF8);
+
+    SECTION("Old snapshot stays valid after a reload")
+    {
+        AudioToolKits::LyricSnapshot snapshot;
+        REQUIRE(snapshot.load() != nullptr);
+        REQUIRE(snapshot.load()->get_text().empty());
+
+        snapshot.reload_file(short_name);
+        const auto before = snapshot.load();
+        snapshot.reload_file(long_name);
+        const auto after = snapshot.load();
+
+        REQUIRE(before->get_text().size() == 1);
+        REQUIRE(after->get_text().size() == 3);
+        REQUIRE(snapshot.version() == 2);
+    }
+
+    SECTION("Readers always see a complete document")
+    {
+        AudioToolKits::LyricSnapshot snapshot{
+            AudioToolKits::LyricSnapshot::parse_file(short_name)
+        };
+        std::atomic<bool> stop{false};
+        std::atomic<bool> torn{false};
+        std::thread reader([&snapshot, &stop, &torn]()
+        {
+            while (!stop.load())
+            {
+                const auto document = snapshot.load();
+                const size_t size = document->get_text().size();
+                if (size != 1 && size != 3)
+                {
+                    torn.store(true);
+                }
+            }
+        });
+        for (int i = 0; i < 50; ++i)
+        {
+            snapshot.reload_file(i % 2 == 0 ? long_name : short_name);
+        }
+        stop.store(true);
+        reader.join();
+        REQUIRE_FALSE(torn.load());
+    }
+}
+
+namespace
+{
+// tasks posted from any thread, run when the owner drains them, like a UI loop
+class TaskQueue
+{
+public:
+    AudioToolKits::LyricAsyncLoader::Executor executor()
+    {
+        return [this](AudioToolKits::LyricAsyncLoader::Task task)
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        };
+    }
+
+    size_t run_all()
+    {
+        std::vector<AudioToolKits::LyricAsyncLoader::Task> tasks;
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            tasks.swap(m_tasks);
+        }
+        for (auto& task : tasks)
+        {
+            task();
+        }
+        return tasks.size();
+    }
+
+private:
+    std::mutex m_mutex;
+
+    std::vector<AudioToolKits::LyricAsyncLoader::Task> m_tasks;
+};
+}
+
+TEST_CASE("LyricAsyncLoaderTest", "Off-thread loads with cancellation")
+{
+    const std::string gbk_name{"async_gbk.lyc"};
+    const std::vector<std::string> gbk_toT{
+        "[ti: 异步]"
+        , "[00:01.000] 第一行"
+        , "[00:02.000] 第二行"
+    };
+    LPTest::ScopedFile gbkHelper(gbk_name);
+    gbkHelper.write_to_file(gbk_toT, LPTest::ScopedFile::Encoding::GBK);
+
+    SECTION("Futures from a worker pool")
+    {
+        AudioToolKits::LyricWorkStealingPool pool{2};
+        AudioToolKits::LyricAsyncLoader loader{pool};
+
+        auto file = loader.load_file(gbk_name);
+        auto buffer = loader.parse_buffer("[ti: buffer]\n[00:01.000] one\n");
+        auto missing = loader.load_file("async_missing.lyc");
+
+        const auto file_result = file.get();
+        REQUIRE(file_result.loaded());
+        REQUIRE(file_result.m_document->get_tags() == std::vector<std::string>{"ti: 异步"});
+        REQUIRE(file_result.m_document->get_text().size() == 2);
+        REQUIRE(std::string_view{file_result.m_document->get_text()[1].m_text} == "第二行");
+
+        const auto buffer_result = buffer.get();
+        REQUIRE(buffer_result.loaded());
+        REQUIRE(buffer_result.m_document->get_text().size() == 1);
+
+        const auto missing_result = missing.get();
+        REQUIRE(missing_result.m_status == AudioToolKits::LyricLoadStatus::Failed);
+        REQUIRE(missing_result.m_document == nullptr);
+    }
+
+    SECTION("Nothing parsed is a failed load")
+    {
+        const AudioToolKits::LyricCancelToken token;
+        for (const std::string_view bytes : {"", " \r\n", "not a lyric\nat all\n"})
+        {
+            const auto result = AudioToolKits::LyricAsyncLoader::parse_buffer_now(bytes, token);
+            REQUIRE(result.m_status == AudioToolKits::LyricLoadStatus::Failed);
+            REQUIRE(result.m_document == nullptr);
+        }
+        const std::string empty_name{"async_empty.lyc"};
+        LPTest::ScopedFile emptyHelper(empty_name);
+        REQUIRE(emptyHelper.write_to_file({"plain text"}));
+        REQUIRE(AudioToolKits::LyricAsyncLoader::load_file_now(empty_name, token).m_status ==
+                AudioToolKits::LyricLoadStatus::Failed);
+    }
+
+    SECTION("A track skip cancels the stale load")
+    {
+        TaskQueue work;
+        TaskQueue ui;
+        AudioToolKits::LyricAsyncLoader loader{work.executor()};
+        std::vector<AudioToolKits::LyricLoadStatus> statuses;
+        const auto record = [&statuses](AudioToolKits::LyricLoadResult&& result)
+        {
+            statuses.push_back(result.m_status);
+        };
+
+        AudioToolKits::LyricCancelToken previous;
+        loader.load_file(gbk_name, previous, ui.executor(), record);
+        previous.cancel();
+        const AudioToolKits::LyricCancelToken current;
+        loader.load_file(gbk_name, current, ui.executor(), record);
+
+        REQUIRE(ui.run_all() == 0);
+        REQUIRE(work.run_all() == 2);
+        REQUIRE(statuses.empty());
+        REQUIRE(ui.run_all() == 2);
+        REQUIRE(statuses == std::vector<AudioToolKits::LyricLoadStatus>{
+            AudioToolKits::LyricLoadStatus::Cancelled
+            , AudioToolKits::LyricLoadStatus::Loaded
+        });
+    }
+
+    SECTION("Cancelling after the parse still drops the result")
+    {
+        TaskQueue work;
+        TaskQueue ui;
+        AudioToolKits::LyricAsyncLoader loader{work.executor()};
+        AudioToolKits::LyricLoadResult delivered{AudioToolKits::LyricLoadStatus::Loaded, nullptr};
+
+        const AudioToolKits::LyricCancelToken token;
+        loader.parse_buffer("[00:01.000] one", token, ui.executor()
+                            , [&delivered](AudioToolKits::LyricLoadResult&& result)
+                            {
+                                delivered = std::move(result);
+                            });
+        work.run_all();
+        token.cancel();
+        ui.run_all();
+        REQUIRE(delivered.m_status == AudioToolKits::LyricLoadStatus::Cancelled);
+        REQUIRE(delivered.m_document == nullptr);
+
+        auto future = loader.parse_buffer("[00:01.000] one", token);
+        work.run_all();
+        REQUIRE(future.get().m_status == AudioToolKits::LyricLoadStatus::Cancelled);
+    }
+}
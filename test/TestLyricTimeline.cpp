@@ -0,0 +1,263 @@
+//
+// Created by 31305 on 2026/10/19.
+//
+#define CATCH_CONFIG_MAIN
+#include "scopedfile.h"
+#include "catch.hpp"
+#include <lyricdispatcher.h>
+#include <lyrickaraoke.h>
+#include <lyriccursor.h>
+#include <lyricbatch.h>
+#include <lyricwindow.h>
+
+namespace
+{
+const std::vector<std::string> s_enhanced_lrc_toT{
+    "[ar: Carpenters]"
+    , "[ti: Yesterday Once More]"
+    , "[00:10.500] <00:10.500> When <00:10.700> I <00:10.800> was <00:11.000> young"
+    , "[00:14.250] <00:14.250> Waitin' <00:14.750> for <00:14.900> my <00:15.150> favorite <00:15.700> songs"
+    , "[00:18.000] <00:18.000> 想 <00:18.200> 你"
+};
+}
+
+TEST_CASE("LyricTimelineWordTest", "Word timings kept by the parser")
+{
+    const std::string filename{"timeline_words.lyc"};
+
+    SECTION("Encode: UTF8")
+    {
+        LPTest::ScopedFile fileHelper(filename);
+        fileHelper.write_to_file(s_enhanced_lrc_toT, LPTest::ScopedFile::Encoding::UTF8);
+        const AudioToolKits::LyricParser lyric_parser{filename};
+        const AudioToolKits::LyricTimeline timeline{lyric_parser};
+
+        REQUIRE(lyric_parser.get_words().size() == 11);
+        REQUIRE(timeline.line_count() == 3);
+        REQUIRE(timeline.line_text(0) == "When I was young");
+        REQUIRE(timeline.word_text(3) == "young");
+        REQUIRE(timeline.word_text(9) == "想");
+        REQUIRE(timeline.find_line(10499) == AudioToolKits::LyricTimeline::npos);
+        REQUIRE(timeline.find_line(14250) == 1);
+        REQUIRE(timeline.find_word(1, 14800) == 5);
+    }
+
+    SECTION("Encode: GBK")
+    {
+        LPTest::ScopedFile fileHelper(filename);
+        fileHelper.write_to_file(s_enhanced_lrc_toT, LPTest::ScopedFile::Encoding::GBK);
+        AudioToolKits::LyricParser lyric_parser{filename};
+        lyric_parser.change_encoding_utf8();
+        const AudioToolKits::LyricTimeline timeline{lyric_parser};
+
+        REQUIRE(timeline.line_text(2) == "想你");
+        REQUIRE(timeline.word_text(9) == "想");
+        REQUIRE(timeline.word_text(10) == "你");
+    }
+}
+
+TEST_CASE("LyricPlaybackDispatcherTest", "Audio clock driven events")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc(s_enhanced_lrc_toT);
+    const auto timeline = std::make_shared<const AudioToolKits::LyricTimeline>(lyric_parser);
+    AudioToolKits::LyricPlaybackDispatcher dispatcher{timeline, 1000, 64};
+
+    const auto drain = [&dispatcher]()
+    {
+        std::vector<AudioToolKits::LyricPlaybackEvent> events;
+        AudioToolKits::LyricPlaybackEvent event;
+        while (dispatcher.poll(event))
+        {
+            events.push_back(event);
+        }
+        return events;
+    };
+
+    SECTION("Line and word changes while playing")
+    {
+        dispatcher.tick(10000);
+        REQUIRE(drain().empty());
+
+        dispatcher.tick(10750);
+        auto events = drain();
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].m_type == AudioToolKits::LyricPlaybackEvent::Type::LineChanged);
+        REQUIRE(events[0].m_line == 0);
+        REQUIRE(events[1].m_type == AudioToolKits::LyricPlaybackEvent::Type::WordChanged);
+        REQUIRE(events[1].m_word == 1);
+
+        dispatcher.tick(10900);
+        events = drain();
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].m_word == 2);
+    }
+
+    SECTION("Seeks and sample rate changes")
+    {
+        dispatcher.tick(18100);
+        dispatcher.tick(14800);
+        auto events = drain();
+        REQUIRE(events.back().m_type == AudioToolKits::LyricPlaybackEvent::Type::Seek);
+        REQUIRE(events.back().m_line == 1);
+        REQUIRE(events.back().m_word == 5);
+
+        // same media position expressed at 2 kHz
+        dispatcher.set_sample_rate(2000);
+        dispatcher.tick(36400);
+        events = drain();
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].m_line == 2);
+        REQUIRE(events[1].m_word == 10);
+        REQUIRE(dispatcher.dropped_events() == 0);
+    }
+}
+
+TEST_CASE("LyricKaraokeCursorTest", "Per-frame word progress")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc(s_enhanced_lrc_toT);
+    const AudioToolKits::LyricTimeline timeline{lyric_parser};
+    AudioToolKits::LyricKaraokeCursor cursor{timeline};
+
+    REQUIRE(cursor.update(0).m_line == AudioToolKits::LyricTimeline::npos);
+
+    auto state = cursor.update(10600);
+    REQUIRE(state.m_line == 0);
+    REQUIRE(state.m_word == 0);
+    REQUIRE(state.m_byte_offset == 0);
+    REQUIRE(state.m_byte_length == 4);
+    REQUIRE(state.m_word_progress == Approx(0.5f));
+
+    // "young" ends where the next line starts
+    state = cursor.update(12625);
+    REQUIRE(state.m_word == 3);
+    REQUIRE(state.m_word_progress == Approx(0.5f));
+
+    // multi-byte words report code points as well as bytes
+    state = cursor.update(18300);
+    REQUIRE(state.m_line == 2);
+    REQUIRE(state.m_word == 10);
+    REQUIRE(state.m_byte_offset == 3);
+    REQUIRE(state.m_byte_length == 3);
+    REQUIRE(state.m_codepoint_offset == 1);
+    REQUIRE(state.m_codepoint_length == 1);
+
+    // backward seek
+    state = cursor.update(14800);
+    REQUIRE(state.m_line == 1);
+    REQUIRE(state.m_word == 5);
+    REQUIRE(state.m_line_progress == Approx(550.0f / 3750.0f));
+}
+
+TEST_CASE("LyricLineCursorTest", "Batched listener cursors")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc(s_enhanced_lrc_toT);
+    const AudioToolKits::LyricTimeline timeline{lyric_parser};
+
+    std::vector<AudioToolKits::LyricLineCursor> cursors(4);
+    std::vector<uint8_t> changed;
+
+    REQUIRE(AudioToolKits::advance_cursors(timeline, cursors, {0, 10500, 15000, 30000}
+                                           , &changed) == 3);
+    REQUIRE_FALSE(cursors[0].has_line());
+    REQUIRE(cursors[1].m_line == 0);
+    REQUIRE(cursors[2].m_line == 1);
+    REQUIRE(cursors[3].m_line == 2);
+    REQUIRE(changed == std::vector<uint8_t>{0, 1, 1, 1});
+
+    // forward, unchanged, backward and back before the first line
+    REQUIRE(AudioToolKits::advance_cursors(timeline, cursors, {18000, 11000, 10600, 100}
+                                           , &changed) == 3);
+    REQUIRE(cursors[0].m_line == 2);
+    REQUIRE(cursors[1].m_line == 0);
+    REQUIRE(cursors[2].m_line == 0);
+    REQUIRE_FALSE(cursors[3].has_line());
+    REQUIRE(changed == std::vector<uint8_t>{1, 0, 1, 1});
+}
+
+TEST_CASE("LyricBatchResolverTest", "Batched time-to-line across documents")
+{
+    AudioToolKits::LyricParser enhanced_parser;
+    enhanced_parser.parse_lrc(s_enhanced_lrc_toT);
+    AudioToolKits::LyricParser normal_parser;
+    normal_parser.parse_lrc({
+        "[ti: normal]"
+        , "[00:01.000] one"
+        , "[00:02.000] two"
+        , "[00:03.000] three"
+    });
+    const AudioToolKits::LyricTimeline enhanced{enhanced_parser};
+    const AudioToolKits::LyricTimeline normal{normal_parser};
+
+    AudioToolKits::LyricBatchResolver resolver{{&enhanced, &normal}};
+    const std::vector<AudioToolKits::LyricTimeQuery> queries{
+        {1, 2500}
+        , {0, 18000}
+        , {1, 500}
+        , {0, 10500}
+        , {1, 90000}
+        , {7, 1000}
+        , {0, 14999}
+    };
+    std::vector<uint32_t> lines;
+    resolver.resolve(queries, lines);
+
+    constexpr uint32_t none{AudioToolKits::LyricLineCursor::s_none};
+    REQUIRE(lines == std::vector<uint32_t>{1, 2, none, 0, 2, none, 1});
+
+    // time-ordered queries take the merge path
+    resolver.resolve({{0, 100}, {1, 1000}, {0, 10500}, {0, 10600}, {0, 20000}, {1, 2999}}
+                     , lines);
+    REQUIRE(lines == std::vector<uint32_t>{none, 0, 0, 0, 2, 1});
+}
+
+TEST_CASE("LyricWindowTest", "Visible line ranges")
+{
+    AudioToolKits::LyricParser lyric_parser;
+    lyric_parser.parse_lrc({
+        "[ti: window]"
+        , "[00:01.000] one"
+        , "[00:02.000] two"
+        , "[00:03.000] three"
+        , "[00:04.000] four"
+        , "[00:05.000] five"
+        , "[00:06.000] six"
+    });
+    const AudioToolKits::LyricTimeline timeline{lyric_parser};
+    using Range = AudioToolKits::LyricLineRange;
+
+    SECTION("Range query")
+    {
+        REQUIRE(timeline.line_range(2500, 4000) == Range{1, 3});
+        REQUIRE(timeline.line_range(2500, 4001) == Range{1, 4});
+        REQUIRE(timeline.line_range(0, 1500) == Range{0, 1});
+        REQUIRE(timeline.line_range(0, 500).empty());
+        REQUIRE(timeline.line_range(2500, 4000, 1, 1) == Range{0, 4});
+        REQUIRE(timeline.line_range(5500, 9000, 0, 3) == Range{4, 6});
+    }
+
+    SECTION("Sliding window")
+    {
+        AudioToolKits::LyricWindowTracker tracker{timeline, 1, 1};
+        auto change = tracker.update(1000, 2000);
+        REQUIRE(change.m_window == Range{0, 2});
+        REQUIRE(change.m_entered[0] == Range{0, 2});
+        REQUIRE(change.m_left[0].empty());
+
+        REQUIRE(tracker.update(1200, 1800).empty());
+
+        change = tracker.update(3000, 4000);
+        REQUIRE(change.m_window == Range{1, 4});
+        REQUIRE(change.m_left[0] == Range{0, 1});
+        REQUIRE(change.m_left[1].empty());
+        REQUIRE(change.m_entered[0].empty());
+        REQUIRE(change.m_entered[1] == Range{2, 4});
+
+        // seek back
+        change = tracker.update(1000, 2000);
+        REQUIRE(change.m_entered[0] == Range{0, 1});
+        REQUIRE(change.m_left[1] == Range{2, 4});
+    }
+}